@@ -0,0 +1,121 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include <GLFW/glfw3.h>
+
+#include <Windowing/Device.hpp>
+#include <Windowing/FrameStatistics.hpp>
+#include <Windowing/InputManager.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	// Frames run before the audit, so all the lazily allocated storage (events, arenas, vectors) exists
+	static constexpr unsigned long long WARMUP_FRAMES = 100;
+
+	static constexpr unsigned long long AUDITED_FRAMES = 10'000;
+
+	// Set every frame, GLFW copies the title on every change, so only an unchanged title can be allocation-free
+	static constexpr std::string_view TITLE = "Benchmark 60 FPS";
+
+	// Drives the whole per-frame path with synthetic events and fails if any of its frames touches the heap
+	void RunAllocationBenchmarks(BenchmarkRunner& runner)
+	{
+		Device device(runner.GetDeviceSpecification());
+		Window window(&device, WindowSpecification{.Title = std::string(TITLE), .IsVisible = false});
+
+		InputManager inputManager(&window);
+		FrameStatistics statistics;
+
+		unsigned long long sink = 0;
+
+		const Eventing::ListenerID keyListener   = window.KeyPressedEvent += [&sink](KeyCode code) { sink += code; };
+		const Eventing::ListenerID mouseListener = window.MouseButtonPressedEvent +=
+		    [&sink](MouseCode code) { sink += code; };
+
+		// The window has no context, so every SwapBuffers call reports an error
+		const Eventing::ListenerID errorListener = Device::ErrorEvent +=
+		    [&sink](int code, std::string_view description) { sink += code + description.size(); };
+
+		GLFWwindow* handle = window.GetWindowHandle();
+
+		// Full path of the OS events: GLFW callback -> FindInstance -> Eventing::Event -> listeners
+		const GLFWkeyfun keyCallback = glfwSetKeyCallback(handle, nullptr);
+		glfwSetKeyCallback(handle, keyCallback);
+
+		const GLFWmousebuttonfun mouseButtonCallback = glfwSetMouseButtonCallback(handle, nullptr);
+		glfwSetMouseButtonCallback(handle, mouseButtonCallback);
+
+		const GLFWscrollfun scrollCallback = glfwSetScrollCallback(handle, nullptr);
+		glfwSetScrollCallback(handle, scrollCallback);
+
+		const GLFWcursorposfun cursorPosCallback = glfwSetCursorPosCallback(handle, nullptr);
+		glfwSetCursorPosCallback(handle, cursorPosCallback);
+
+		const GLFWcharfun charCallback = glfwSetCharCallback(handle, nullptr);
+		glfwSetCharCallback(handle, charCallback);
+
+		unsigned long long frame = 0;
+
+		const auto runFrame = [&]() {
+			device.PollEvents();
+
+			keyCallback(handle, KeyCode::Space, 0, GLFW_PRESS, 0);
+			mouseButtonCallback(handle, MouseCode::ButtonLeft, GLFW_PRESS, 0);
+			scrollCallback(handle, 0.0, 1.0);
+			cursorPosCallback(handle, (double)(frame % 100), 20.0);
+			charCallback(handle, 0x0105); // two bytes in UTF-8
+
+			inputManager.UpdateKeysStateIfNecessary();
+			DoNotOptimize(inputManager.PublishSnapshot().Version);
+
+			keyCallback(handle, KeyCode::Space, 0, GLFW_RELEASE, 0);
+			mouseButtonCallback(handle, MouseCode::ButtonLeft, GLFW_RELEASE, 0);
+
+			window.SetTitle(TITLE);
+			window.SwapBuffers();
+
+			statistics.AddFrameTimestamp(device.GetPreciseElapsedTime());
+
+			inputManager.ClearReleasedKeys();
+			window.ClearTextInput();
+
+			frame++;
+		};
+
+		for (unsigned long long i = 0; i < WARMUP_FRAMES; i++)
+			runFrame();
+
+		const AllocationStatistics before = GetAllocationStatistics();
+		const auto start                  = std::chrono::steady_clock::now();
+
+		for (unsigned long long i = 0; i < AUDITED_FRAMES; i++)
+			runFrame();
+
+		const auto end                   = std::chrono::steady_clock::now();
+		const AllocationStatistics after = GetAllocationStatistics();
+
+		const unsigned long long allocations = after.Count - before.Count;
+
+		runner.Record("Frame/Allocations", AUDITED_FRAMES,
+		              std::chrono::duration<double, std::nano>(end - start).count(),
+		              {
+		                  {"Allocations/Frame", (double)allocations / (double)AUDITED_FRAMES},
+		                  {"Bytes/Frame", (double)(after.Bytes - before.Bytes) / (double)AUDITED_FRAMES},
+		              });
+
+		if (allocations > 0)
+			runner.Fail("Frame/Allocations: " + std::to_string(allocations) + " heap allocations after the warm-up");
+
+		window.KeyPressedEvent -= keyListener;
+		window.MouseButtonPressedEvent -= mouseListener;
+		Device::ErrorEvent -= errorListener;
+
+		DoNotOptimize(sink);
+	}
+
+} // namespace SW::Windowing::Benchmarks
@@ -0,0 +1,156 @@
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+	#include <malloc.h>
+#endif
+
+#include <GLFW/glfw3.h>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	static std::atomic<unsigned long long> s_ALLOCATION_COUNT = 0;
+	static std::atomic<unsigned long long> s_ALLOCATED_BYTES  = 0;
+
+	AllocationStatistics GetAllocationStatistics()
+	{
+		return {
+		    .Count = s_ALLOCATION_COUNT.load(std::memory_order_relaxed),
+		    .Bytes = s_ALLOCATED_BYTES.load(std::memory_order_relaxed),
+		};
+	}
+
+	static void CountAllocation(std::size_t size)
+	{
+		s_ALLOCATION_COUNT.fetch_add(1, std::memory_order_relaxed);
+		s_ALLOCATED_BYTES.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	static void* Allocate(std::size_t size)
+	{
+		CountAllocation(size);
+
+		if (void* pointer = std::malloc(size != 0 ? size : 1))
+			return pointer;
+
+		throw std::bad_alloc();
+	}
+
+	static void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		CountAllocation(size);
+
+		const std::size_t align = (std::size_t)alignment;
+
+#ifdef _WIN32
+		// MSVC has no aligned_alloc, its aligned blocks must be released by _aligned_free
+		void* pointer = _aligned_malloc(size != 0 ? size : 1, align);
+#else
+		// aligned_alloc requires the size to be a multiple of the alignment
+		const std::size_t rounded = (size + align - 1) / align * align;
+
+		void* pointer = std::aligned_alloc(align, rounded != 0 ? rounded : align);
+#endif
+
+		if (pointer)
+			return pointer;
+
+		throw std::bad_alloc();
+	}
+
+	static void FreeAligned(void* pointer)
+	{
+#ifdef _WIN32
+		_aligned_free(pointer);
+#else
+		std::free(pointer);
+#endif
+	}
+
+	void InstallGLFWAllocationTracking()
+	{
+		static const GLFWallocator allocator = {
+		    .allocate = [](size_t size, void* /*user*/) -> void* {
+			    CountAllocation(size);
+
+			    return std::malloc(size);
+		    },
+		    .reallocate = [](void* block, size_t size, void* /*user*/) -> void* {
+			    CountAllocation(size);
+
+			    return std::realloc(block, size);
+		    },
+		    .deallocate = [](void* block, void* /*user*/) { std::free(block); },
+		    .user       = nullptr,
+		};
+
+		glfwInitAllocator(&allocator);
+	}
+
+} // namespace SW::Windowing::Benchmarks
+
+// Replaced for the whole benchmark executable, GLFW allocations are tracked by InstallGLFWAllocationTracking
+
+void* operator new(std::size_t size)
+{
+	return SW::Windowing::Benchmarks::Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return SW::Windowing::Benchmarks::Allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept
+{
+	std::free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return SW::Windowing::Benchmarks::AllocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return SW::Windowing::Benchmarks::AllocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t /*alignment*/) noexcept
+{
+	SW::Windowing::Benchmarks::FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t /*alignment*/) noexcept
+{
+	SW::Windowing::Benchmarks::FreeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	SW::Windowing::Benchmarks::FreeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+	SW::Windowing::Benchmarks::FreeAligned(pointer);
+}
@@ -0,0 +1,125 @@
+/**
+ * @file Benchmark.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <Windowing/Device.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+	struct BenchmarkCounter
+	{
+		std::string Name;
+
+		double Value = 0.0;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+
+		unsigned long long Iterations = 0;
+
+		// Average wall time of a single iteration
+		double NanosecondsPerIteration = 0.0;
+
+		// Additional per iteration measurements (e.g. number of emitted events)
+		std::vector<BenchmarkCounter> Counters;
+	};
+
+	struct AllocationStatistics
+	{
+		// Total number of operator new calls since the startup
+		unsigned long long Count = 0;
+
+		// Total number of bytes requested from operator new since the startup
+		unsigned long long Bytes = 0;
+	};
+
+	// Heap usage of the whole process, tracked by the replaced global operator new (aligned ones included)
+	// and, once installed, by the GLFW allocator
+	AllocationStatistics GetAllocationStatistics();
+
+	// Routes the GLFW allocations through the counters, call before the first device is created
+	void InstallGLFWAllocationTracking();
+
+	// Defined out of line, so the compiler has to assume the pointed value is read
+	void EscapePointer(const void* pointer);
+
+	// Makes the value observable, so the compiler can not optimize away its computation
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		EscapePointer(&value);
+	}
+
+	class BenchmarkRunner
+	{
+	public:
+		BenchmarkRunner(Platform platform) : m_Platform(platform) {}
+
+		// Device specification every benchmark should use, so the whole suite runs on the selected platform
+		DeviceSpecification GetDeviceSpecification() const
+		{
+			DeviceSpecification spec;
+
+			spec.Api      = ClientApi::Vulkan; // no context, so the null platform works too
+			spec.Platform = m_Platform;
+
+			return spec;
+		}
+
+		// Writes all the recorded results as JSON, for the regression tracking
+		bool WriteJSON(const std::string& path) const;
+
+		// Runs the function the given number of times (after a short warm-up) and records the average time
+		template <typename Func>
+		void Run(const std::string& name, unsigned long long iterations, Func&& func)
+		{
+			for (unsigned long long i = 0; i < iterations / 10 + 1; ++i)
+				func();
+
+			const auto start = std::chrono::steady_clock::now();
+
+			for (unsigned long long i = 0; i < iterations; ++i)
+				func();
+
+			const auto end = std::chrono::steady_clock::now();
+
+			Record(name, iterations, std::chrono::duration<double, std::nano>(end - start).count());
+		}
+
+		// Records an externally measured result (total time of all iterations)
+		void Record(const std::string& name, unsigned long long iterations, double totalNanoseconds,
+		            std::vector<BenchmarkCounter> counters = {});
+
+		const std::vector<BenchmarkResult>& GetResults() const { return m_Results; }
+
+		// Reports a broken guarantee (e.g. an allocation on the hot path), the executable then exits with an error
+		void Fail(const std::string& message);
+
+		bool HasFailed() const { return m_FailureCount > 0; }
+
+	private:
+		Platform m_Platform;
+
+		std::vector<BenchmarkResult> m_Results;
+
+		int m_FailureCount = 0;
+	};
+
+	void RunAllocationBenchmarks(BenchmarkRunner& runner);
+	void RunEventDispatchBenchmarks(BenchmarkRunner& runner);
+	void RunFixedTimestepBenchmarks(BenchmarkRunner& runner);
+	void RunFramePipelineBenchmarks(BenchmarkRunner& runner);
+	void RunFullscreenBenchmarks(BenchmarkRunner& runner);
+	void RunInputManagerBenchmarks(BenchmarkRunner& runner);
+	void RunLifetimeBenchmarks(BenchmarkRunner& runner);
+
+} // namespace SW::Windowing::Benchmarks
@@ -0,0 +1,130 @@
+#include "Benchmark.hpp"
+
+#include <GLFW/glfw3.h>
+
+#include <Windowing/Device.hpp>
+#include <Windowing/StaticEventDispatcher.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	// Stands in for a hot listener such as the input manager or the renderer
+	struct CountingSink
+	{
+		unsigned long long Count = 0;
+
+		void OnKeyPressed(KeyCode code) { Count += code; }
+		void OnMouseButtonPressed(MouseCode code) { Count += code; }
+		void OnMouseScrollWheel(float xOffset, float yOffset) { Count += (unsigned long long)(xOffset + yOffset); }
+		void OnResize(int width, int height) { Count += width + height; }
+		void OnFramebufferResize(int width, int height) { Count += width + height; }
+		void OnMove(int x, int y) { Count += x + y; }
+		void OnCursorMove(float x, float y) { Count += (unsigned long long)(x + y); }
+		void OnGainFocus() { ++Count; }
+	};
+
+	static constexpr unsigned long long DISPATCH_ITERATIONS = 1'000'000;
+
+	// Events recorded between two polls by the batched dispatch benchmark
+	static constexpr int BATCH_SIZE = 100;
+
+	void RunEventDispatchBenchmarks(BenchmarkRunner& runner)
+	{
+		Device device(runner.GetDeviceSpecification());
+		Window window(&device, WindowSpecification{.Title = "Benchmark", .IsVisible = false});
+
+		CountingSink dynamicSink;
+		CountingSink staticSink;
+
+		window.KeyPressedEvent += [&dynamicSink](KeyCode code) { dynamicSink.OnKeyPressed(code); };
+		window.MouseButtonPressedEvent += [&dynamicSink](MouseCode code) { dynamicSink.OnMouseButtonPressed(code); };
+		window.MouseScrollWheelEvent += [&dynamicSink](float x, float y) { dynamicSink.OnMouseScrollWheel(x, y); };
+		window.ResizeEvent += [&dynamicSink](int width, int height) { dynamicSink.OnResize(width, height); };
+		window.FramebufferResizeEvent +=
+		    [&dynamicSink](int width, int height) { dynamicSink.OnFramebufferResize(width, height); };
+		window.MoveEvent += [&dynamicSink](int x, int y) { dynamicSink.OnMove(x, y); };
+		window.CursorMoveEvent += [&dynamicSink](float x, float y) { dynamicSink.OnCursorMove(x, y); };
+		window.GainFocusEvent += [&dynamicSink]() { dynamicSink.OnGainFocus(); };
+
+		GLFWwindow* handle = window.GetWindowHandle();
+
+		// Full path of an OS event: GLFW callback -> FindInstance -> Eventing::Event -> listener
+		const GLFWkeyfun keyCallback = glfwSetKeyCallback(handle, nullptr);
+		glfwSetKeyCallback(handle, keyCallback);
+
+		const GLFWmousebuttonfun mouseButtonCallback = glfwSetMouseButtonCallback(handle, nullptr);
+		glfwSetMouseButtonCallback(handle, mouseButtonCallback);
+
+		const GLFWscrollfun scrollCallback = glfwSetScrollCallback(handle, nullptr);
+		glfwSetScrollCallback(handle, scrollCallback);
+
+		const GLFWcursorposfun cursorPosCallback = glfwSetCursorPosCallback(handle, nullptr);
+		glfwSetCursorPosCallback(handle, cursorPosCallback);
+
+		runner.Run("Dispatch/KeyPressed/Callback", DISPATCH_ITERATIONS,
+		           [=]() { keyCallback(handle, KeyCode::Space, 0, GLFW_PRESS, 0); });
+		runner.Run("Dispatch/MouseButtonPressed/Callback", DISPATCH_ITERATIONS,
+		           [=]() { mouseButtonCallback(handle, MouseCode::ButtonLeft, GLFW_PRESS, 0); });
+		runner.Run("Dispatch/MouseScrollWheel/Callback", DISPATCH_ITERATIONS,
+		           [=]() { scrollCallback(handle, 0.0, 1.0); });
+		runner.Run("Dispatch/CursorMove/Callback", DISPATCH_ITERATIONS,
+		           [=]() { cursorPosCallback(handle, 10.0, 20.0); });
+
+		// A frame's worth of cursor moves, delivered to a bulk consumer by a single invocation per poll
+		const Eventing::ListenerID batchListener = window.AddBatchListener(
+		    [&dynamicSink](std::span<const EventRecord> records) { dynamicSink.Count += records.size(); });
+
+		runner.Run("Dispatch/CursorMove/Batched", DISPATCH_ITERATIONS / BATCH_SIZE, [&]() {
+			for (int i = 0; i < BATCH_SIZE; i++)
+				cursorPosCallback(handle, 10.0, 20.0);
+
+			device.PollEvents();
+		});
+
+		window.RemoveBatchListener(batchListener);
+
+		StaticEventDispatcher<CountingSink> dispatcher(&window, staticSink);
+
+		runner.Run("Dispatch/KeyPressed/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.KeyPressedEvent.Invoke(KeyCode::Space); });
+		runner.Run("Dispatch/KeyPressed/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchKeyPressed(KeyCode::Space); });
+
+		runner.Run("Dispatch/MouseButtonPressed/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.MouseButtonPressedEvent.Invoke(MouseCode::ButtonLeft); });
+		runner.Run("Dispatch/MouseButtonPressed/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchMouseButtonPressed(MouseCode::ButtonLeft); });
+
+		runner.Run("Dispatch/MouseScrollWheel/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.MouseScrollWheelEvent.Invoke(0.0f, 1.0f); });
+		runner.Run("Dispatch/MouseScrollWheel/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchMouseScrollWheel(0.0f, 1.0f); });
+
+		runner.Run("Dispatch/Resize/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.ResizeEvent.Invoke(800, 600); });
+		runner.Run("Dispatch/Resize/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchResize(800, 600); });
+
+		runner.Run("Dispatch/FramebufferResize/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.FramebufferResizeEvent.Invoke(800, 600); });
+		runner.Run("Dispatch/FramebufferResize/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchFramebufferResize(800, 600); });
+
+		runner.Run("Dispatch/Move/Dynamic", DISPATCH_ITERATIONS, [&window]() { window.MoveEvent.Invoke(10, 20); });
+		runner.Run("Dispatch/Move/Static", DISPATCH_ITERATIONS, [&dispatcher]() { dispatcher.DispatchMove(10, 20); });
+
+		runner.Run("Dispatch/CursorMove/Dynamic", DISPATCH_ITERATIONS,
+		           [&window]() { window.CursorMoveEvent.Invoke(10.0f, 20.0f); });
+		runner.Run("Dispatch/CursorMove/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchCursorMove(10.0f, 20.0f); });
+
+		runner.Run("Dispatch/GainFocus/Dynamic", DISPATCH_ITERATIONS, [&window]() { window.GainFocusEvent.Invoke(); });
+		runner.Run("Dispatch/GainFocus/Static", DISPATCH_ITERATIONS,
+		           [&dispatcher]() { dispatcher.DispatchGainFocus(); });
+
+		DoNotOptimize(dynamicSink.Count);
+		DoNotOptimize(staticSink.Count);
+	}
+
+} // namespace SW::Windowing::Benchmarks
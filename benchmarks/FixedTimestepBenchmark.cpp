@@ -0,0 +1,95 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <Windowing/FixedTimestep.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	// Powers of two, so the steps and the frame times are exact in double precision
+	static constexpr double TICK_RATE = 64.0;
+	static constexpr double STEP      = 1.0 / TICK_RATE;
+
+	static void Expect(BenchmarkRunner& runner, bool condition, const std::string& check)
+	{
+		if (!condition)
+			runner.Fail("FixedTimestep: " + check);
+	}
+
+	// Deterministic checks of the tick accounting, the benchmarks have no separate test target
+	static void CheckFixedTimestep(BenchmarkRunner& runner)
+	{
+		{
+			FixedTimestep timestep(TICK_RATE);
+
+			Expect(runner, timestep.Advance(5.0) == 0, "the first Advance call only starts the clock");
+			Expect(runner, timestep.Advance(5.0 + 2.0 * STEP) == 2, "two steps long frame runs two ticks");
+
+			// 1.5 steps per frame alternates between 1 and 2 ticks
+			for (int i = 0; i < 4; i++)
+				timestep.AddFrameTime(1.5 * STEP);
+
+			Expect(runner, timestep.GetTickCount() == 8, "tick count of the given frame times");
+			Expect(runner, timestep.GetLastFrameTickCount() == 2, "last frame tick count");
+			Expect(runner, timestep.GetDroppedTickCount() == 0, "no dropped ticks below MaxSteps");
+			Expect(runner, timestep.GetAlpha() == 0.0f, "no time left after whole steps");
+		}
+
+		{
+			FixedTimestep timestep(TICK_RATE, 4);
+
+			Expect(runner, timestep.AddFrameTime(10.0 * STEP) == 4, "ticks clamped to MaxSteps");
+			Expect(runner, timestep.GetDroppedTickCount() == 6, "ticks above MaxSteps are dropped");
+			Expect(runner, timestep.GetAlpha() == 0.0f, "dropped time is not accumulated");
+
+			Expect(runner, timestep.AddFrameTime(0.5 * STEP) == 0, "partial step runs no tick");
+			Expect(runner, timestep.GetAlpha() == 0.5f, "alpha of a half step");
+
+			timestep.Reset();
+
+			Expect(runner, timestep.GetTickCount() == 0, "Reset clears the tick count");
+			Expect(runner, timestep.GetDroppedTickCount() == 0, "Reset clears the dropped tick count");
+			Expect(runner, timestep.GetLastFrameTickCount() == 0, "Reset clears the last frame");
+			Expect(runner, timestep.GetAverageTicksPerFrame() == 0.0, "Reset clears the average");
+			Expect(runner, timestep.GetAlpha() == 0.0f, "Reset clears the accumulated time");
+			Expect(runner, timestep.Advance(100.0) == 0, "Advance after Reset starts the clock again");
+			Expect(runner, timestep.Advance(100.0 + STEP) == 1, "Advance after Reset");
+		}
+
+		{
+			// Inexact step and frame times, the rounding errors must not push alpha out of its range
+			FixedTimestep timestep(60.0, 1000);
+
+			bool inRange = true;
+
+			for (int i = 0; i < 100'000; i++)
+			{
+				timestep.AddFrameTime(0.001 * (i % 37) + 1.0 / 60.0 * (i % 3));
+
+				const float alpha = timestep.GetAlpha();
+
+				inRange = inRange && alpha >= 0.0f && alpha < 1.0f;
+			}
+
+			Expect(runner, inRange, "alpha stays in range [0, 1)");
+		}
+	}
+
+	void RunFixedTimestepBenchmarks(BenchmarkRunner& runner)
+	{
+		CheckFixedTimestep(runner);
+
+		FixedTimestep timestep(60.0);
+
+		double time = 0.0;
+
+		runner.Run("FixedTimestep/Advance", 1'000'000, [&]() {
+			time += 1.0 / 144.0;
+
+			DoNotOptimize(timestep.Advance(time));
+		});
+	}
+
+} // namespace SW::Windowing::Benchmarks
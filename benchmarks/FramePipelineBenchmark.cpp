@@ -0,0 +1,84 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <GLFW/glfw3.h>
+
+#include <Windowing/FramePipeline.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	static constexpr int CHECKED_FRAMES = 4;
+
+	// A key press must be in exactly one frame's snapshot, no matter how many frames are in flight
+	static void CheckKeyPressedOnce(BenchmarkRunner& runner, Device& device, Window& window, int framesInFlight)
+	{
+		int pressedFrames = 0;
+		int downFrames    = 0;
+
+		FramePipelineSpecification spec;
+
+		spec.FramesInFlight = framesInFlight;
+		spec.Simulate       = [](FrameContext& /*frame*/) {};
+		spec.Render         = [](const FrameContext& /*frame*/) {};
+
+		// Main thread, in the submission order
+		spec.Input = [&](FrameContext& frame) {
+			pressedFrames += frame.Input.IsKeyPressed(KeyCode::Space) ? 1 : 0;
+			downFrames += frame.Input.IsKeyDown(KeyCode::Space) ? 1 : 0;
+		};
+
+		GLFWwindow* handle = window.GetWindowHandle();
+
+		const GLFWkeyfun keyCallback = glfwSetKeyCallback(handle, nullptr);
+		glfwSetKeyCallback(handle, keyCallback);
+
+		{
+			FramePipeline pipeline(&device, &window, spec);
+
+			keyCallback(handle, KeyCode::Space, 0, GLFW_PRESS, 0);
+
+			for (int i = 0; i < CHECKED_FRAMES; i++)
+				pipeline.RunFrame();
+
+			keyCallback(handle, KeyCode::Space, 0, GLFW_RELEASE, 0);
+
+			pipeline.RunFrame();
+			pipeline.Flush();
+		}
+
+		const std::string name = "FramePipeline (" + std::to_string(framesInFlight) + " in flight): ";
+
+		if (pressedFrames != 1)
+			runner.Fail(name + "key press in " + std::to_string(pressedFrames) + " snapshots, expected 1");
+
+		if (downFrames != CHECKED_FRAMES)
+			runner.Fail(name + "key down in " + std::to_string(downFrames) + " snapshots, expected " +
+			            std::to_string(CHECKED_FRAMES));
+	}
+
+	void RunFramePipelineBenchmarks(BenchmarkRunner& runner)
+	{
+		Device device(runner.GetDeviceSpecification());
+		Window window(&device, WindowSpecification{.Title = "Benchmark", .IsVisible = false});
+
+		CheckKeyPressedOnce(runner, device, window, 1);
+		CheckKeyPressedOnce(runner, device, window, 2);
+
+		FramePipelineSpecification spec;
+
+		spec.Simulate = [](FrameContext& frame) { DoNotOptimize(frame.Index); };
+		spec.Render   = [](const FrameContext& frame) { DoNotOptimize(frame.Slot); };
+
+		FramePipeline pipeline(&device, &window, spec);
+
+		// Overhead of the stages hand-off, poll and swap included
+		runner.Run("FramePipeline/RunFrame", 10'000, [&]() { pipeline.RunFrame(); });
+
+		pipeline.Flush();
+	}
+
+} // namespace SW::Windowing::Benchmarks
@@ -0,0 +1,78 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+
+#include <GLFW/glfw3.h>
+
+#include <Windowing/Device.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	static constexpr int FULLSCREEN_TOGGLES = 10;
+
+	// Time given to the platform to deliver the events caused by a single toggle
+	static constexpr double FULLSCREEN_SETTLE_SECONDS = 0.25;
+
+	static void SettleEvents(Device& device)
+	{
+		const double deadline = glfwGetTime() + FULLSCREEN_SETTLE_SECONDS;
+
+		while (glfwGetTime() < deadline)
+		{
+			glfwWaitEventsTimeout(deadline - glfwGetTime());
+			device.PollEvents();
+		}
+	}
+
+	static void MeasureToggle(BenchmarkRunner& runner, Device& device, Window& window, FullscreenMode mode,
+	                          const std::string& name)
+	{
+		int resizeEvents            = 0;
+		int framebufferResizeEvents = 0;
+
+		const Eventing::ListenerID resizeListener = window.ResizeEvent += [&resizeEvents](int, int) {
+			++resizeEvents;
+		};
+		const Eventing::ListenerID framebufferResizeListener = window.FramebufferResizeEvent +=
+		    [&framebufferResizeEvents](int, int) { ++framebufferResizeEvents; };
+
+		double totalNanoseconds = 0.0;
+
+		for (int i = 0; i < FULLSCREEN_TOGGLES; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			window.ToggleFullscreen(mode); // enter
+			window.ToggleFullscreen(mode); // leave
+
+			const auto end = std::chrono::steady_clock::now();
+
+			totalNanoseconds += std::chrono::duration<double, std::nano>(end - start).count();
+
+			SettleEvents(device);
+		}
+
+		window.ResizeEvent -= resizeListener;
+		window.FramebufferResizeEvent -= framebufferResizeListener;
+
+		runner.Record(name, FULLSCREEN_TOGGLES, totalNanoseconds,
+		              {
+		                  {"ResizeEvents", (double)resizeEvents / FULLSCREEN_TOGGLES},
+		                  {"FramebufferResizeEvents", (double)framebufferResizeEvents / FULLSCREEN_TOGGLES},
+		              });
+	}
+
+	void RunFullscreenBenchmarks(BenchmarkRunner& runner)
+	{
+		Device device(runner.GetDeviceSpecification());
+		Window window(&device, WindowSpecification{.Title = "Benchmark", .Width = 800, .Height = 600});
+
+		SettleEvents(device);
+
+		MeasureToggle(runner, device, window, FullscreenMode::Exclusive, "Fullscreen/Toggle/Exclusive");
+		MeasureToggle(runner, device, window, FullscreenMode::Borderless, "Fullscreen/Toggle/Borderless");
+	}
+
+} // namespace SW::Windowing::Benchmarks
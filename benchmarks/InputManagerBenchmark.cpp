@@ -0,0 +1,90 @@
+#include "Benchmark.hpp"
+
+#include <string>
+
+#include <Windowing/Device.hpp>
+#include <Windowing/InputManager.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	static constexpr unsigned long long INPUT_ITERATIONS = 100'000;
+
+	// Number of distinct keys pressed before measuring, the whole printable and function key range at most
+	static constexpr int TRACKED_KEY_COUNTS[] = {1, 8, 32, 128, 317};
+
+	void RunInputManagerBenchmarks(BenchmarkRunner& runner)
+	{
+		Device device(runner.GetDeviceSpecification());
+		Window window(&device, WindowSpecification{.Title = "Benchmark", .IsVisible = false});
+
+		for (const int trackedKeys : TRACKED_KEY_COUNTS)
+		{
+			InputManager inputManager(&window);
+
+			for (int i = 0; i < trackedKeys; i++)
+				window.KeyPressedEvent.Invoke((KeyCode)(KeyCode::Space + i));
+
+			const std::string suffix = "/" + std::to_string(trackedKeys);
+
+			bool isDown = false;
+
+			runner.Run("InputManager/IsKeyDown" + suffix, INPUT_ITERATIONS,
+			           [&]() { isDown ^= inputManager.IsKeyDown(KeyCode::Space); });
+
+			runner.Run("InputManager/FrameUpdate" + suffix, INPUT_ITERATIONS, [&]() {
+				inputManager.UpdateKeysStateIfNecessary();
+				inputManager.ClearReleasedKeys();
+			});
+
+			runner.Run("InputManager/PublishSnapshot" + suffix, INPUT_ITERATIONS,
+			           [&]() { DoNotOptimize(inputManager.PublishSnapshot().Version); });
+
+			// One press and release of every tracked key per frame
+			runner.Run("InputManager/KeyEvents" + suffix, INPUT_ITERATIONS / 100, [&]() {
+				for (int i = 0; i < trackedKeys; i++)
+				{
+					window.KeyPressedEvent.Invoke((KeyCode)(KeyCode::Space + i));
+					window.KeyReleasedEvent.Invoke((KeyCode)(KeyCode::Space + i));
+				}
+
+				inputManager.UpdateKeysStateIfNecessary();
+				inputManager.ClearReleasedKeys();
+			});
+
+			DoNotOptimize(isDown);
+		}
+
+		// UI, overlay and game layers over a single shared input state
+		InputManager inputManager(&window);
+		InputContext game, overlay, ui;
+
+		ui.ClaimMouseButton(MouseCode::ButtonLeft);
+		overlay.ClaimKey(KeyCode::Escape);
+
+		inputManager.PushContext(game);
+		inputManager.PushContext(overlay);
+		inputManager.PushContext(ui);
+
+		window.MouseButtonPressedEvent.Invoke(MouseCode::ButtonLeft);
+
+		bool isDown = false;
+
+		runner.Run("InputContext/IsMouseButtonDown", INPUT_ITERATIONS,
+		           [&]() { isDown ^= game.IsMouseButtonDown(MouseCode::ButtonLeft); });
+
+		runner.Run("InputContext/FrameUpdate/3", INPUT_ITERATIONS, [&]() {
+			inputManager.UpdateKeysStateIfNecessary();
+			ui.ConsumeMouseButton(MouseCode::ButtonRight);
+			inputManager.ClearReleasedKeys();
+		});
+
+		inputManager.PopContext(ui);
+		inputManager.PopContext(overlay);
+		inputManager.PopContext(game);
+
+		DoNotOptimize(isDown);
+	}
+
+} // namespace SW::Windowing::Benchmarks
@@ -0,0 +1,89 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Windowing/Device.hpp>
+#include <Windowing/InputManager.hpp>
+#include <Windowing/Window.hpp>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	static constexpr unsigned long long DEVICE_STARTUPS   = 20;
+	static constexpr unsigned long long WINDOW_CREATIONS  = 50;
+	static constexpr unsigned long long LOOKUP_ITERATIONS = 1'000'000;
+
+	static constexpr int WINDOW_COUNTS[] = {1, 8, 64};
+
+	// Records the size and the heap usage of a window, optionally observed by an input manager
+	static void RecordWindowFootprint(BenchmarkRunner& runner, Device& device, const WindowSpecification& spec,
+	                                  bool withInputManager)
+	{
+		const AllocationStatistics before = GetAllocationStatistics();
+		AllocationStatistics after;
+
+		{
+			Window window(&device, spec);
+
+			if (withInputManager)
+			{
+				InputManager inputManager(&window);
+
+				after = GetAllocationStatistics();
+			}
+			else
+			{
+				after = GetAllocationStatistics();
+			}
+		}
+
+		runner.Record(withInputManager ? "Window/Footprint/InputManager" : "Window/Footprint", 1, 0.0,
+		              {
+		                  {"SizeOf", (double)sizeof(Window)},
+		                  {"HeapAllocations", (double)(after.Count - before.Count)},
+		                  {"HeapBytes", (double)(after.Bytes - before.Bytes)},
+		              });
+	}
+
+	void RunLifetimeBenchmarks(BenchmarkRunner& runner)
+	{
+		const DeviceSpecification deviceSpec = runner.GetDeviceSpecification();
+
+		runner.Run("Device/Startup", DEVICE_STARTUPS, [&deviceSpec]() { Device device(deviceSpec); });
+
+		Device device(deviceSpec);
+
+		const WindowSpecification windowSpec = {.Title = "Benchmark", .IsVisible = false};
+
+		runner.Run("Window/CreateDestroy", WINDOW_CREATIONS, [&]() { Window window(&device, windowSpec); });
+
+		RecordWindowFootprint(runner, device, windowSpec, false);
+		RecordWindowFootprint(runner, device, windowSpec, true);
+
+		device.PrewarmWindows(windowSpec, 1);
+
+		runner.Run("Window/PoolAcquireRelease", WINDOW_CREATIONS,
+		           [&]() { device.ReleaseWindow(device.AcquireWindow(windowSpec)); });
+
+		for (const int windowCount : WINDOW_COUNTS)
+		{
+			std::vector<std::unique_ptr<Window>> windows;
+
+			for (int i = 0; i < windowCount; i++)
+				windows.push_back(std::make_unique<Window>(&device, windowSpec));
+
+			GLFWwindow* lastHandle = windows.back()->GetWindowHandle();
+
+			Window* found = nullptr;
+
+			runner.Run("Window/FindInstance/" + std::to_string(windowCount), LOOKUP_ITERATIONS,
+			           [&]() { found = Window::FindInstance(lastHandle); });
+
+			DoNotOptimize(found);
+		}
+	}
+
+} // namespace SW::Windowing::Benchmarks
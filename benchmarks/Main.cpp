@@ -0,0 +1,142 @@
+#include "Benchmark.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace SW::Windowing::Benchmarks
+{
+
+	const void* volatile g_EscapedPointer = nullptr;
+
+	void EscapePointer(const void* pointer)
+	{
+		g_EscapedPointer = pointer;
+	}
+
+	void BenchmarkRunner::Record(const std::string& name, unsigned long long iterations, double totalNanoseconds,
+	                             std::vector<BenchmarkCounter> counters)
+	{
+		BenchmarkResult& result = m_Results.emplace_back();
+
+		result.Name                    = name;
+		result.Iterations              = iterations;
+		result.NanosecondsPerIteration = iterations > 0 ? totalNanoseconds / (double)iterations : 0.0;
+		result.Counters                = std::move(counters);
+
+		std::printf("%-56s %12llu iterations %14.2f ns/iteration\n", result.Name.c_str(), result.Iterations,
+		            result.NanosecondsPerIteration);
+
+		for (const BenchmarkCounter& counter : result.Counters)
+			std::printf("    %-52s %14.2f\n", counter.Name.c_str(), counter.Value);
+	}
+
+	void BenchmarkRunner::Fail(const std::string& message)
+	{
+		std::fprintf(stderr, "FAILED: %s\n", message.c_str());
+
+		m_FailureCount++;
+	}
+
+	bool BenchmarkRunner::WriteJSON(const std::string& path) const
+	{
+		std::ofstream file(path);
+
+		if (!file)
+			return false;
+
+		file << "{\n  \"benchmarks\": [\n";
+
+		for (size_t i = 0; i < m_Results.size(); i++)
+		{
+			const BenchmarkResult& result = m_Results[i];
+
+			file << "    {\"name\": \"" << result.Name << "\", \"iterations\": " << result.Iterations
+			     << ", \"ns_per_iteration\": " << result.NanosecondsPerIteration << ", \"counters\": {";
+
+			for (size_t j = 0; j < result.Counters.size(); j++)
+			{
+				file << (j > 0 ? ", " : "") << "\"" << result.Counters[j].Name << "\": " << result.Counters[j].Value;
+			}
+
+			file << "}}" << (i + 1 < m_Results.size() ? "," : "") << "\n";
+		}
+
+		file << "  ]\n}\n";
+
+		return (bool)file;
+	}
+
+	// Without a display server (e.g. CI machines) fall back to the null platform
+	static Platform GetDefaultPlatform()
+	{
+#if defined(__linux__)
+		if (std::getenv("DISPLAY") == nullptr && std::getenv("WAYLAND_DISPLAY") == nullptr)
+			return Platform::Null;
+#endif
+
+		return Platform::Any;
+	}
+
+} // namespace SW::Windowing::Benchmarks
+
+// Usage: SW.Module.Windowing.Benchmarks [--platform any|null|x11|wayland] [--json <path>]
+int main(int argc, char** argv)
+{
+	using namespace SW::Windowing;
+	using namespace SW::Windowing::Benchmarks;
+
+	Platform platform = GetDefaultPlatform();
+
+	const char* jsonPath = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+		{
+			jsonPath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--platform") == 0 && i + 1 < argc)
+		{
+			const char* name = argv[++i];
+
+			if (std::strcmp(name, "null") == 0)
+				platform = Platform::Null;
+			else if (std::strcmp(name, "x11") == 0)
+				platform = Platform::X11;
+			else if (std::strcmp(name, "wayland") == 0)
+				platform = Platform::Wayland;
+			else
+				platform = Platform::Any;
+		}
+		else
+		{
+			std::fprintf(stderr, "Usage: %s [--platform any|null|x11|wayland] [--json <path>]\n", argv[0]);
+
+			return 1;
+		}
+	}
+
+	InstallGLFWAllocationTracking();
+
+	BenchmarkRunner runner(platform);
+
+	RunLifetimeBenchmarks(runner);
+	RunEventDispatchBenchmarks(runner);
+	RunInputManagerBenchmarks(runner);
+	RunFullscreenBenchmarks(runner);
+	RunAllocationBenchmarks(runner);
+	RunFixedTimestepBenchmarks(runner);
+	RunFramePipelineBenchmarks(runner);
+
+	if (jsonPath != nullptr && !runner.WriteJSON(jsonPath))
+	{
+		std::fprintf(stderr, "Failed to write the results to %s\n", jsonPath);
+
+		return 1;
+	}
+
+	return runner.HasFailed() ? 1 : 0;
+}
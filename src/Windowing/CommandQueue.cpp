@@ -0,0 +1,98 @@
+#include "CommandQueue.hpp"
+
+namespace SW::Windowing
+{
+
+	CommandQueue::CommandQueue() : m_Head(&m_Stub), m_Tail(&m_Stub)
+	{
+	}
+
+	CommandQueue::~CommandQueue()
+	{
+		// Not executed commands are dropped (their completion futures become broken)
+		while (Node* node = PopNode())
+			delete node;
+	}
+
+	void CommandQueue::Push(Command command)
+	{
+		Node* node = new Node;
+
+		node->Value = std::move(command);
+
+		PushNode(node);
+	}
+
+	int CommandQueue::Execute()
+	{
+		int executed = 0;
+
+		while (Node* node = PopNode())
+		{
+			node->Value();
+
+			delete node;
+
+			executed++;
+		}
+
+		return executed;
+	}
+
+	bool CommandQueue::IsEmpty() const
+	{
+		return m_Tail == &m_Stub && m_Stub.Next.load(std::memory_order_acquire) == nullptr;
+	}
+
+	void CommandQueue::PushNode(Node* node)
+	{
+		node->Next.store(nullptr, std::memory_order_relaxed);
+
+		Node* previous = m_Head.exchange(node, std::memory_order_acq_rel);
+
+		// Between the exchange and this store the node is not reachable by the consumer yet
+		previous->Next.store(node, std::memory_order_release);
+	}
+
+	CommandQueue::Node* CommandQueue::PopNode()
+	{
+		Node* tail = m_Tail;
+		Node* next = tail->Next.load(std::memory_order_acquire);
+
+		if (tail == &m_Stub)
+		{
+			if (next == nullptr)
+				return nullptr;
+
+			m_Tail = next;
+			tail   = next;
+			next   = next->Next.load(std::memory_order_acquire);
+		}
+
+		if (next != nullptr)
+		{
+			m_Tail = next;
+
+			return tail;
+		}
+
+		// Some producer is in the middle of a push, the node will be available on the next call
+		if (tail != m_Head.load(std::memory_order_acquire))
+			return nullptr;
+
+		// The tail is the last node, put the stub behind it so it can be detached
+		PushNode(&m_Stub);
+
+		next = tail->Next.load(std::memory_order_acquire);
+
+		if (next != nullptr)
+		{
+			m_Tail = next;
+
+			return tail;
+		}
+
+		return nullptr;
+	}
+
+} // namespace SW::Windowing
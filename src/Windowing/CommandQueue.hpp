@@ -0,0 +1,62 @@
+/**
+ * @file CommandQueue.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+
+namespace SW::Windowing
+{
+
+	// Lock-free multi-producer, single-consumer queue of commands.
+	// Any thread can push, only one thread (the main thread) can execute.
+	class CommandQueue
+	{
+	public:
+		using Command = std::function<void()>;
+
+		CommandQueue();
+		~CommandQueue();
+
+		CommandQueue(const CommandQueue&)            = delete;
+		CommandQueue& operator=(const CommandQueue&) = delete;
+
+		// Thread-safe, never blocks
+		void Push(Command command);
+
+		// Executes all the commands pushed so far (in order), returns the number of executed commands.
+		// Only the consumer thread may call it.
+		int Execute();
+
+		// Whether there is no command to execute (pushes in progress are not visible yet).
+		// Only the consumer thread may call it.
+		bool IsEmpty() const;
+
+	private:
+		struct Node
+		{
+			std::atomic<Node*> Next = nullptr;
+
+			Command Value;
+		};
+
+		void PushNode(Node* node);
+
+		// Returns the oldest node (owned by the caller) or nullptr if there is none (or its push is in progress)
+		Node* PopNode();
+
+	private:
+		// Last pushed node, producers swap it
+		std::atomic<Node*> m_Head;
+
+		// Oldest node, touched only by the consumer
+		Node* m_Tail;
+
+		// Placeholder keeping the list non-empty
+		Node m_Stub;
+	};
+
+} // namespace SW::Windowing
@@ -0,0 +1,262 @@
+#include "Coroutine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include <GLFW/glfw3.h>
+
+namespace SW::Windowing
+{
+
+	struct FreeFrame
+	{
+		FreeFrame* Next = nullptr;
+	};
+
+	// Heads of the free lists per size class
+	static std::array<FreeFrame*, CoroutineFramePool::ClassCount> s_FREE_FRAMES = {};
+
+	static size_t GetSizeClass(size_t size)
+	{
+		return size == 0 ? 0 : (size - 1) / CoroutineFramePool::Granularity;
+	}
+
+	// Heap order of the sleepers, the earliest wake time on top
+	static constexpr auto s_IS_LATER = [](const auto& first, const auto& second) {
+		return first.WakeTime > second.WakeTime;
+	};
+
+	void* CoroutineFramePool::Allocate(size_t size)
+	{
+		const size_t sizeClass = GetSizeClass(size);
+
+		if (sizeClass >= ClassCount)
+			return ::operator new(size);
+
+		FreeFrame*& head = s_FREE_FRAMES[sizeClass];
+
+		if (head == nullptr)
+		{
+			// Chunks are never returned to the heap, their frames are recycled
+			const size_t frameSize = (sizeClass + 1) * Granularity;
+			std::byte* chunk       = static_cast<std::byte*>(::operator new(frameSize * FramesPerChunk));
+
+			for (size_t i = 0; i < FramesPerChunk; i++)
+			{
+				FreeFrame* frame = new (chunk + i * frameSize) FreeFrame{head};
+				head             = frame;
+			}
+		}
+
+		FreeFrame* frame = head;
+		head             = frame->Next;
+
+		return frame;
+	}
+
+	void CoroutineFramePool::Free(void* frame, size_t size)
+	{
+		const size_t sizeClass = GetSizeClass(size);
+
+		if (sizeClass >= ClassCount)
+		{
+			::operator delete(frame);
+
+			return;
+		}
+
+		s_FREE_FRAMES[sizeClass] = new (frame) FreeFrame{s_FREE_FRAMES[sizeClass]};
+	}
+
+	Task::promise_type::~promise_type()
+	{
+		if (Scheduler)
+			Scheduler->Unlink(*this);
+	}
+
+	Task::~Task()
+	{
+		// Never spawned, never started
+		if (m_Handle)
+			m_Handle.destroy();
+	}
+
+	void NextFrameAwaiter::await_suspend(std::coroutine_handle<Task::promise_type> handle) const
+	{
+		handle.promise().Scheduler->m_NextFrame.push_back(handle);
+	}
+
+	void DelayAwaiter::await_suspend(std::coroutine_handle<Task::promise_type> handle) const
+	{
+		std::vector<TaskScheduler::Sleeper>& sleepers = handle.promise().Scheduler->m_Sleepers;
+
+		sleepers.push_back({glfwGetTime() + Seconds, handle});
+		std::push_heap(sleepers.begin(), sleepers.end(), s_IS_LATER);
+	}
+
+	void WindowEventAwaiter::await_suspend(std::coroutine_handle<Task::promise_type> handle) const
+	{
+		handle.promise().Scheduler->m_Waiters[{Target, Event, Code}].push_back(handle);
+	}
+
+	size_t TaskScheduler::WaitKeyHash::operator()(const WaitKey& key) const
+	{
+		const size_t target = std::hash<const Window*>()(key.Target);
+
+		return target ^ ((size_t)key.Event << 16) ^ ((size_t)key.Code * 0x9E3779B1u);
+	}
+
+	TaskScheduler::~TaskScheduler()
+	{
+		DestroyTasks();
+	}
+
+	void TaskScheduler::Spawn(Task task)
+	{
+		std::coroutine_handle<Task::promise_type> handle = task.m_Handle;
+		task.m_Handle                                    = nullptr;
+
+		Task::promise_type& promise = handle.promise();
+
+		promise.Scheduler = this;
+		promise.Next      = m_Tasks;
+
+		if (m_Tasks)
+			m_Tasks->Previous = &promise;
+
+		m_Tasks = &promise;
+		m_TaskCount++;
+
+		handle.resume();
+	}
+
+	void TaskScheduler::Update(double time)
+	{
+		if (m_TaskCount == 0)
+			return;
+
+		m_Resuming.swap(m_Ready);
+
+		for (std::coroutine_handle<> handle : m_NextFrame)
+			m_Resuming.push_back({nullptr, handle});
+
+		m_NextFrame.clear();
+
+		while (!m_Sleepers.empty() && m_Sleepers.front().WakeTime <= time)
+		{
+			std::pop_heap(m_Sleepers.begin(), m_Sleepers.end(), s_IS_LATER);
+
+			m_Resuming.push_back({nullptr, m_Sleepers.back().Handle});
+			m_Sleepers.pop_back();
+		}
+
+		// The resumed tasks only append to the other lists, but may forget (destroy) the later ones here.
+		// Indexed, the entry is cleared before resuming so a task destroying its own window is not destroyed.
+		for (size_t i = 0; i < m_Resuming.size(); i++)
+		{
+			const std::coroutine_handle<> handle = std::exchange(m_Resuming[i].Handle, nullptr);
+
+			if (handle)
+				handle.resume();
+		}
+
+		m_Resuming.clear();
+	}
+
+	double TaskScheduler::GetTimeUntilWake(double time) const
+	{
+		if (!m_Ready.empty() || !m_NextFrame.empty())
+			return 0.0;
+
+		if (!m_Sleepers.empty())
+			return std::max(m_Sleepers.front().WakeTime - time, 0.0);
+
+		return std::numeric_limits<double>::infinity();
+	}
+
+	void TaskScheduler::Signal(const Window* window, WaitEvent event, int code)
+	{
+		if (m_Waiters.empty())
+			return;
+
+		auto it = m_Waiters.find({window, event, code});
+
+		if (it == m_Waiters.end())
+			return;
+
+		for (std::coroutine_handle<> handle : it->second)
+			m_Ready.push_back({window, handle});
+
+		m_Waiters.erase(it);
+	}
+
+	void TaskScheduler::ForgetWindow(const Window* window)
+	{
+		if (m_Waiters.empty() && m_Ready.empty() && m_Resuming.empty())
+			return;
+
+		std::vector<std::coroutine_handle<>> forgotten;
+
+		// Signaled already, but not resumed yet
+		std::erase_if(m_Ready, [window, &forgotten](const ReadyTask& task) {
+			if (task.Target != window)
+				return false;
+
+			forgotten.push_back(task.Handle);
+
+			return true;
+		});
+
+		// Forgotten by a task resumed by the current update
+		for (ReadyTask& task : m_Resuming)
+		{
+			if (task.Target == window && task.Handle)
+				forgotten.push_back(std::exchange(task.Handle, nullptr));
+		}
+
+		std::erase_if(m_Waiters, [window, &forgotten](const auto& waiters) {
+			if (waiters.first.Target != window)
+				return false;
+
+			forgotten.insert(forgotten.end(), waiters.second.begin(), waiters.second.end());
+
+			return true;
+		});
+
+		// Destroyed once unlisted, as the destructors of their locals may spawn or forget too.
+		// Every suspended task is in a single list, destroying a frame unlinks its promise.
+		for (std::coroutine_handle<> handle : forgotten)
+			handle.destroy();
+	}
+
+	void TaskScheduler::DestroyTasks()
+	{
+		// Destroying a frame unlinks its promise
+		while (m_Tasks)
+			std::coroutine_handle<Task::promise_type>::from_promise(*m_Tasks).destroy();
+
+		m_NextFrame.clear();
+		m_Ready.clear();
+		m_Sleepers.clear();
+		m_Waiters.clear();
+	}
+
+	void TaskScheduler::Unlink(Task::promise_type& promise)
+	{
+		if (promise.Previous)
+			promise.Previous->Next = promise.Next;
+		else
+			m_Tasks = promise.Next;
+
+		if (promise.Next)
+			promise.Next->Previous = promise.Previous;
+
+		m_TaskCount--;
+	}
+
+} // namespace SW::Windowing
@@ -0,0 +1,222 @@
+/**
+ * @file Coroutine.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <unordered_map>
+#include <vector>
+
+namespace SW::Windowing
+{
+	class Window;
+	class TaskScheduler;
+
+	// Recycles the coroutine frames per size class, so spawning a task does not go to the heap every time.
+	// Main thread only, like the tasks themselves.
+	class CoroutineFramePool
+	{
+	public:
+		// Frame sizes are rounded up to a multiple of the granularity
+		static constexpr size_t Granularity = 64;
+
+		// Frames up to ClassCount * Granularity bytes are pooled, the larger ones use the heap directly
+		static constexpr size_t ClassCount = 16;
+
+		// Number of frames allocated at once when a size class runs out
+		static constexpr size_t FramesPerChunk = 64;
+
+		static void* Allocate(size_t size);
+		static void Free(void* frame, size_t size);
+	};
+
+	// Coroutine started with Device::Spawn. Runs until its first suspension immediately, then it is resumed by
+	// the device's scheduler (during PollEvents/WaitEvents) once the awaited frame, time or window event comes.
+	// Waiting tasks cost nothing but their frames until then.
+	class Task
+	{
+	public:
+		struct promise_type
+		{
+			~promise_type();
+
+			Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+			// Started by TaskScheduler::Spawn, destroyed automatically once finished
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+
+			static void* operator new(size_t size) { return CoroutineFramePool::Allocate(size); }
+			static void operator delete(void* frame, size_t size) { CoroutineFramePool::Free(frame, size); }
+
+			TaskScheduler* Scheduler = nullptr;
+
+			// Intrusive list of the scheduler's live tasks
+			promise_type* Previous = nullptr;
+			promise_type* Next     = nullptr;
+		};
+
+	public:
+		Task(Task&& other) noexcept : m_Handle(other.m_Handle) { other.m_Handle = nullptr; }
+		~Task();
+
+		Task(const Task&)            = delete;
+		Task& operator=(const Task&) = delete;
+		Task& operator=(Task&&)      = delete;
+
+	private:
+		explicit Task(std::coroutine_handle<promise_type> handle) : m_Handle(handle) {}
+
+	private:
+		friend class TaskScheduler;
+
+		// Null once spawned (the scheduler owns the frame)
+		std::coroutine_handle<promise_type> m_Handle;
+	};
+
+	enum class WaitEvent
+	{
+		KeyPressed,
+		Resized,
+	};
+
+	struct NextFrameAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<Task::promise_type> handle) const;
+		void await_resume() const noexcept {}
+	};
+
+	struct DelayAwaiter
+	{
+		double Seconds = 0.0;
+
+		bool await_ready() const noexcept { return Seconds <= 0.0; }
+		void await_suspend(std::coroutine_handle<Task::promise_type> handle) const;
+		void await_resume() const noexcept {}
+	};
+
+	// Returned by Window::KeyPressed and Window::Resized
+	struct WindowEventAwaiter
+	{
+		const Window* Target = nullptr;
+
+		WaitEvent Event = WaitEvent::KeyPressed;
+
+		// Key code for WaitEvent::KeyPressed
+		int Code = 0;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<Task::promise_type> handle) const;
+		void await_resume() const noexcept {}
+	};
+
+	// Resumes the task during the next PollEvents/WaitEvents call
+	inline NextFrameAwaiter NextFrame()
+	{
+		return {};
+	}
+
+	// Resumes the task during the first PollEvents/WaitEvents call after the duration has passed
+	inline DelayAwaiter Delay(std::chrono::duration<double> duration)
+	{
+		return {duration.count()};
+	}
+
+	// Owned by the Device, resumes the waiting tasks once per PollEvents/WaitEvents call.
+	// Tasks resumed during an update that wait again are resumed by the next update at the earliest.
+	class TaskScheduler
+	{
+	public:
+		TaskScheduler() = default;
+		~TaskScheduler();
+
+		TaskScheduler(const TaskScheduler&)            = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+		// Takes over the task and runs it until its first suspension
+		void Spawn(Task task);
+
+		// Resumes the tasks whose frame, time (in seconds of the GLFW timer) or window event has come
+		void Update(double time);
+
+		// Seconds until a task has to be resumed (0 if some already waits for the next update), infinity if none
+		double GetTimeUntilWake(double time) const;
+
+		// Called by the window callbacks, a single branch when no task waits for any window event
+		void Signal(const Window* window, WaitEvent event, int code);
+
+		// Destroys the tasks waiting for the window's events, including the signaled ones not resumed yet
+		void ForgetWindow(const Window* window);
+
+		// Destroys all the live tasks, suspended or not
+		void DestroyTasks();
+
+		int GetTaskCount() const { return m_TaskCount; }
+
+	private:
+		// Task to resume, with the window whose event it waited for (null for the frame and time waits)
+		struct ReadyTask
+		{
+			const Window* Target = nullptr;
+
+			std::coroutine_handle<> Handle;
+		};
+
+		struct Sleeper
+		{
+			double WakeTime = 0.0;
+
+			std::coroutine_handle<> Handle;
+		};
+
+		struct WaitKey
+		{
+			const Window* Target = nullptr;
+			WaitEvent Event      = WaitEvent::KeyPressed;
+			int Code             = 0;
+
+			bool operator==(const WaitKey& other) const = default;
+		};
+
+		struct WaitKeyHash
+		{
+			size_t operator()(const WaitKey& key) const;
+		};
+
+	private:
+		friend struct NextFrameAwaiter;
+		friend struct DelayAwaiter;
+		friend struct WindowEventAwaiter;
+		friend struct Task::promise_type;
+
+		void Unlink(Task::promise_type& promise);
+
+	private:
+		std::vector<std::coroutine_handle<>> m_NextFrame;
+
+		// Tasks whose window event has come, resumed by the next update
+		std::vector<ReadyTask> m_Ready;
+
+		// Tasks being resumed by the current update (null once resumed or forgotten), kept to reuse the storage
+		std::vector<ReadyTask> m_Resuming;
+
+		// Min-heap by the wake time
+		std::vector<Sleeper> m_Sleepers;
+
+		std::unordered_map<WaitKey, std::vector<std::coroutine_handle<>>, WaitKeyHash> m_Waiters;
+
+		// Head of the intrusive list of the live tasks
+		Task::promise_type* m_Tasks = nullptr;
+		int m_TaskCount             = 0;
+	};
+
+} // namespace SW::Windowing
@@ -1,19 +1,200 @@
 #include "Device.hpp"
 
+#include "Window.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include <GLFW/glfw3.h>
 #include <stb_image.h>
 
 namespace SW::Windowing
 {
 
-	SW::Eventing::Event<int, std::string> Device::ErrorEvent;
+	SW::Eventing::Event<int, std::string_view> Device::ErrorEvent;
+
+	Device* Device::s_INSTANCE = nullptr;
+
+	static VideoMode ToVideoMode(const GLFWvidmode* mode)
+	{
+		return {
+		    .Width       = mode->width,
+		    .Height      = mode->height,
+		    .RefreshRate = mode->refreshRate,
+		    .RedBits     = mode->redBits,
+		    .GreenBits   = mode->greenBits,
+		    .BlueBits    = mode->blueBits,
+		};
+	}
+
+	static MonitorInfo QueryMonitor(GLFWmonitor* monitor, bool isPrimary)
+	{
+		MonitorInfo info;
+
+		info.Handle    = monitor;
+		info.IsPrimary = isPrimary;
+
+		if (const char* name = glfwGetMonitorName(monitor))
+			info.Name = name;
+
+		glfwGetMonitorPos(monitor, &info.Position.first, &info.Position.second);
+		glfwGetMonitorWorkarea(monitor, &info.WorkArea.X, &info.WorkArea.Y, &info.WorkArea.Width,
+		                       &info.WorkArea.Height);
+		glfwGetMonitorContentScale(monitor, &info.ContentScale.first, &info.ContentScale.second);
+
+		if (const GLFWvidmode* mode = glfwGetVideoMode(monitor))
+			info.CurrentMode = ToVideoMode(mode);
+
+		int modesCount           = 0;
+		const GLFWvidmode* modes = glfwGetVideoModes(monitor, &modesCount);
+
+		info.Modes.reserve(modesCount);
+
+		for (int i = 0; i < modesCount; i++)
+			info.Modes.push_back(ToVideoMode(&modes[i]));
+
+		return info;
+	}
+
+	static GLFWcursor* DecodeCursor(const CursorImage& image)
+	{
+		GLFWimage cursor;
+
+		int channels;
+
+		cursor.pixels = stbi_load_from_memory(image.Image.Data, image.Image.Size, &cursor.width, &cursor.height,
+		                                      &channels, 4);
+
+		if (cursor.pixels == nullptr)
+			return nullptr;
+
+		// GLFW copies the pixels
+		GLFWcursor* instance = glfwCreateCursor(&cursor, image.HotspotX, image.HotspotY);
+
+		stbi_image_free(cursor.pixels);
+
+		return instance;
+	}
+
+	struct KeyName
+	{
+		KeyCode Key;
+
+		std::string_view Name;
+	};
+
+	// GLFW names only the printable keys, the rest is named the same on every layout
+	static constexpr KeyName s_NON_PRINTABLE_KEY_NAMES[] = {
+	    {KeyCode::Space, "Space"},
+	    {KeyCode::Escape, "Escape"},
+	    {KeyCode::Enter, "Enter"},
+	    {KeyCode::Tab, "Tab"},
+	    {KeyCode::Backspace, "Backspace"},
+	    {KeyCode::Insert, "Insert"},
+	    {KeyCode::Delete, "Delete"},
+	    {KeyCode::Right, "Right"},
+	    {KeyCode::Left, "Left"},
+	    {KeyCode::Down, "Down"},
+	    {KeyCode::Up, "Up"},
+	    {KeyCode::PageUp, "Page Up"},
+	    {KeyCode::PageDown, "Page Down"},
+	    {KeyCode::Home, "Home"},
+	    {KeyCode::End, "End"},
+	    {KeyCode::CapsLock, "Caps Lock"},
+	    {KeyCode::ScrollLock, "Scroll Lock"},
+	    {KeyCode::NumLock, "Num Lock"},
+	    {KeyCode::PrintScreen, "Print Screen"},
+	    {KeyCode::Pause, "Pause"},
+	    {KeyCode::F1, "F1"},
+	    {KeyCode::F2, "F2"},
+	    {KeyCode::F3, "F3"},
+	    {KeyCode::F4, "F4"},
+	    {KeyCode::F5, "F5"},
+	    {KeyCode::F6, "F6"},
+	    {KeyCode::F7, "F7"},
+	    {KeyCode::F8, "F8"},
+	    {KeyCode::F9, "F9"},
+	    {KeyCode::F10, "F10"},
+	    {KeyCode::F11, "F11"},
+	    {KeyCode::F12, "F12"},
+	    {KeyCode::F13, "F13"},
+	    {KeyCode::F14, "F14"},
+	    {KeyCode::F15, "F15"},
+	    {KeyCode::F16, "F16"},
+	    {KeyCode::F17, "F17"},
+	    {KeyCode::F18, "F18"},
+	    {KeyCode::F19, "F19"},
+	    {KeyCode::F20, "F20"},
+	    {KeyCode::F21, "F21"},
+	    {KeyCode::F22, "F22"},
+	    {KeyCode::F23, "F23"},
+	    {KeyCode::F24, "F24"},
+	    {KeyCode::F25, "F25"},
+	    {KeyCode::KPEnter, "Keypad Enter"},
+	    {KeyCode::LeftShift, "Left Shift"},
+	    {KeyCode::LeftControl, "Left Control"},
+	    {KeyCode::LeftAlt, "Left Alt"},
+	    {KeyCode::LeftSuper, "Left Super"},
+	    {KeyCode::RightShift, "Right Shift"},
+	    {KeyCode::RightControl, "Right Control"},
+	    {KeyCode::RightAlt, "Right Alt"},
+	    {KeyCode::RightSuper, "Right Super"},
+	    {KeyCode::Menu, "Menu"},
+	};
+
+	static std::string_view GetNonPrintableKeyName(KeyCode key)
+	{
+		for (const KeyName& keyName : s_NON_PRINTABLE_KEY_NAMES)
+		{
+			if (keyName.Key == key)
+				return keyName.Name;
+		}
+
+		return {};
+	}
 
-	Device::Device(const DeviceSpecification& spec)
+	Device::Device(const DeviceSpecification& spec) : m_Api(spec.Api)
 	{
 		glfwSetErrorCallback([](int code, const char* description) { ErrorEvent.Invoke(code, description); });
 
+		switch (spec.Platform)
+		{
+		case Platform::Any:
+			glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+			break;
+		case Platform::Win32:
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_WIN32);
+			break;
+		case Platform::Cocoa:
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_COCOA);
+			break;
+		case Platform::Wayland:
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_WAYLAND);
+			break;
+		case Platform::X11:
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
+			break;
+		case Platform::Null:
+			glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+			break;
+		}
+
 		ASSERT(glfwInit(), "Failed to initialize GLFW");
 
+		ASSERT(s_INSTANCE == nullptr, "Only one device can exist at a time!");
+
+		s_INSTANCE = this;
+
+		RefreshMonitors();
+		RefreshKeyboardLayout();
+
+		glfwSetMonitorCallback([](GLFWmonitor* monitor, int event) {
+			ASSERT(s_INSTANCE, "Device instance is null!");
+
+			s_INSTANCE->OnMonitorEvent(monitor, event);
+		});
+
 		auto loadCursor = [this](const char* path, CursorShape shape) -> void {
 			if (path != nullptr)
 			{
@@ -25,6 +206,8 @@ namespace SW::Windowing
 				VERIFY(icon.pixels, "Failed to load cursor image: {}", path);
 
 				m_Cursors[shape] = glfwCreateCursor(&icon, 0, 0);
+
+				stbi_image_free(icon.pixels);
 			}
 			else
 			{
@@ -65,6 +248,12 @@ namespace SW::Windowing
 
 	Device::~Device()
 	{
+		// Tasks may own windows or wait for their events
+		m_Scheduler.DestroyTasks();
+
+		// The windows still use the cursors
+		m_WindowPool.clear();
+
 		glfwDestroyCursor(m_Cursors[CursorShape::ARROW]);
 		glfwDestroyCursor(m_Cursors[CursorShape::IBEAM]);
 		glfwDestroyCursor(m_Cursors[CursorShape::CROSSHAIR]);
@@ -76,14 +265,100 @@ namespace SW::Windowing
 		glfwDestroyCursor(m_Cursors[CursorShape::RESIZE_ALL]);
 		glfwDestroyCursor(m_Cursors[CursorShape::NOT_ALLOWED]);
 
+		for (const CustomCursor& cursor : m_CustomCursors)
+		{
+			for (GLFWcursor* frame : cursor.Frames)
+				glfwDestroyCursor(frame);
+		}
+
+		glfwSetMonitorCallback(nullptr);
+
+		s_INSTANCE = nullptr;
+
 		glfwTerminate();
 	}
 
 	std::pair<int, int> Device::GetPrimaryMonitorSize() const
 	{
-		const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+		const VideoMode& mode = GetPrimaryMonitor().CurrentMode;
+
+		return {mode.Width, mode.Height};
+	}
+
+	const MonitorInfo& Device::GetPrimaryMonitor() const
+	{
+		ASSERT(!m_Monitors.empty(), "No monitor is connected!");
+
+		return m_Monitors.front();
+	}
+
+	const MonitorInfo* Device::FindMonitor(GLFWmonitor* handle) const
+	{
+		for (const MonitorInfo& monitor : m_Monitors)
+		{
+			if (monitor.Handle == handle)
+				return &monitor;
+		}
+
+		return nullptr;
+	}
+
+	const MonitorInfo* Device::FindMonitorAt(int x, int y) const
+	{
+		for (const MonitorInfo& monitor : m_Monitors)
+		{
+			const int right  = monitor.Position.first + monitor.CurrentMode.Width;
+			const int bottom = monitor.Position.second + monitor.CurrentMode.Height;
+
+			if (x >= monitor.Position.first && x < right && y >= monitor.Position.second && y < bottom)
+				return &monitor;
+		}
+
+		return nullptr;
+	}
+
+	void Device::RefreshMonitors()
+	{
+		int count              = 0;
+		GLFWmonitor** monitors = glfwGetMonitors(&count);
+
+		m_Monitors.clear();
+		m_Monitors.reserve(count);
+
+		// GLFW guarantees the primary monitor to be the first one
+		for (int i = 0; i < count; i++)
+			m_Monitors.push_back(QueryMonitor(monitors[i], i == 0));
+
+		MonitorsChangedEvent.Invoke();
+	}
+
+	void Device::OnMonitorEvent(GLFWmonitor* monitor, int event)
+	{
+		if (event == GLFW_CONNECTED)
+		{
+			RefreshMonitors();
+
+			if (const MonitorInfo* info = FindMonitor(monitor))
+				MonitorConnectedEvent.Invoke(*info);
+		}
+		else if (event == GLFW_DISCONNECTED)
+		{
+			const MonitorInfo* cached = FindMonitor(monitor);
+
+			if (cached == nullptr)
+			{
+				RefreshMonitors();
+
+				return;
+			}
 
-		return {mode->width, mode->height};
+			// The handle stays valid only until this callback returns
+			const MonitorInfo info = *cached;
+
+			RefreshMonitors();
+
+			MonitorDisconnectedEvent.Invoke(info);
+		}
 	}
 
 	GLFWcursor* Device::GetCursorInstance(CursorShape shape) const
@@ -91,21 +366,365 @@ namespace SW::Windowing
 		return m_Cursors.at(shape);
 	}
 
+	CursorID Device::CreateCursor(const CursorImage& image)
+	{
+		return CreateAnimatedCursor({.Frames = std::span(&image, 1)});
+	}
+
+	CursorID Device::CreateAnimatedCursor(const AnimatedCursorSpecification& spec)
+	{
+		ASSERT(!spec.Frames.empty(), "Cursor must have at least one frame!");
+		ASSERT(spec.FrameDuration > 0.0f, "Cursor frame duration must be positive!");
+
+		CustomCursorKey key;
+
+		key.FrameDuration = spec.FrameDuration;
+		key.Frames.reserve(spec.Frames.size());
+
+		for (const CursorImage& image : spec.Frames)
+			key.Frames.push_back({image.Image.Data, image.Image.Size, image.HotspotX, image.HotspotY});
+
+		if (auto it = m_CustomCursorIDs.find(key); it != m_CustomCursorIDs.end())
+			return it->second;
+
+		CustomCursor cursor;
+
+		cursor.FrameDuration = spec.FrameDuration;
+		cursor.Frames.reserve(spec.Frames.size());
+
+		for (const CursorImage& image : spec.Frames)
+		{
+			GLFWcursor* frame = DecodeCursor(image);
+
+			if (frame == nullptr)
+			{
+				for (GLFWcursor* created : cursor.Frames)
+					glfwDestroyCursor(created);
+
+				return InvalidCursor;
+			}
+
+			cursor.Frames.push_back(frame);
+		}
+
+		const CursorID id = (CursorID)m_CustomCursors.size();
+
+		m_CustomCursors.push_back(std::move(cursor));
+		m_CustomCursorIDs[std::move(key)] = id;
+
+		return id;
+	}
+
+	size_t Device::CustomCursorKeyHash::operator()(const CustomCursorKey& key) const
+	{
+		size_t hash = std::hash<float>()(key.FrameDuration);
+
+		for (const CustomCursorKey::Frame& frame : key.Frames)
+		{
+			hash = hash * 31 + std::hash<const uchar*>()(frame.Data);
+			hash = hash * 31 + (size_t)frame.Size;
+			hash = hash * 31 + (size_t)frame.HotspotX;
+			hash = hash * 31 + (size_t)frame.HotspotY;
+		}
+
+		return hash;
+	}
+
+	GLFWcursor* Device::GetCursorInstance(CursorID cursor) const
+	{
+		ASSERT(cursor >= 0 && cursor < (CursorID)m_CustomCursors.size(), "Invalid cursor!");
+
+		const CustomCursor& custom = m_CustomCursors[cursor];
+
+		return custom.Frames[custom.CurrentFrame];
+	}
+
+	bool Device::IsAnimatedCursor(CursorID cursor) const
+	{
+		return cursor >= 0 && cursor < (CursorID)m_CustomCursors.size() && m_CustomCursors[cursor].Frames.size() > 1;
+	}
+
+	void Device::AttachAnimatedCursor(GLFWwindow* window, CursorID cursor)
+	{
+		// The window has just set the current frame
+		m_AnimatedCursorWindows[window] = {cursor, m_CustomCursors[cursor].CurrentFrame};
+	}
+
+	void Device::DetachAnimatedCursor(GLFWwindow* window)
+	{
+		m_AnimatedCursorWindows.erase(window);
+	}
+
+	void Device::UpdateCursorAnimations()
+	{
+		if (m_AnimatedCursorWindows.empty())
+			return;
+
+		const double time = glfwGetTime();
+
+		for (auto& [window, animation] : m_AnimatedCursorWindows)
+		{
+			CustomCursor& cursor = m_CustomCursors[animation.Cursor];
+
+			// All the windows show the same frame of the cursor
+			cursor.CurrentFrame = (int)((unsigned long long)(time / cursor.FrameDuration) % cursor.Frames.size());
+
+			if (animation.Frame == cursor.CurrentFrame)
+				continue;
+
+			animation.Frame = cursor.CurrentFrame;
+
+			glfwSetCursor(window, cursor.Frames[animation.Frame]);
+		}
+	}
+
+	void Device::PrewarmWindows(const WindowSpecification& spec, int count)
+	{
+		m_WindowPool.reserve(m_WindowPool.size() + count);
+
+		for (int i = 0; i < count; i++)
+			CreatePooledWindow(spec);
+	}
+
+	Window* Device::AcquireWindow(const WindowSpecification& spec)
+	{
+		Window* window = nullptr;
+
+		for (PooledWindow& pooled : m_WindowPool)
+		{
+			// Contexts can not be re-shared, a window sharing with another one would fail to resolve its objects
+			if (!pooled.IsAcquired && pooled.HasTitlebar == spec.HasTitlebar &&
+			    pooled.SharedContext == spec.SharedContext)
+			{
+				window            = pooled.Instance.get();
+				pooled.IsAcquired = true;
+
+				break;
+			}
+		}
+
+		if (window == nullptr)
+		{
+			window = CreatePooledWindow(spec);
+
+			m_WindowPool.back().IsAcquired = true;
+		}
+
+		window->Reuse(spec);
+
+		return window;
+	}
+
+	void Device::ReleaseWindow(Window* window)
+	{
+		for (PooledWindow& pooled : m_WindowPool)
+		{
+			if (pooled.Instance.get() == window)
+			{
+				ASSERT(pooled.IsAcquired, "Window was already released!");
+
+				window->Recycle();
+
+				pooled.IsAcquired = false;
+
+				return;
+			}
+		}
+
+		ASSERT(false, "Window does not belong to the pool!");
+	}
+
+	Window* Device::CreatePooledWindow(const WindowSpecification& spec)
+	{
+		ASSERT(!spec.IsFullScreen, "Pooled windows can not be created full screen!");
+
+		WindowSpecification hidden = spec;
+
+		hidden.IsVisible = false;
+
+		// Sharing requires a context, GLFW fails the window creation without one
+		if (hidden.SharedContext == nullptr && !m_WindowPool.empty() && HasContext())
+			hidden.SharedContext = m_WindowPool.front().Instance.get();
+
+		m_WindowPool.push_back({
+		    .Instance      = std::make_unique<Window>(this, hidden),
+		    .HasTitlebar   = spec.HasTitlebar,
+		    .SharedContext = spec.SharedContext,
+		});
+
+		return m_WindowPool.back().Instance.get();
+	}
+
+	std::string_view Device::GetKeyName(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount ? m_KeyNames[key] : std::string_view();
+	}
+
+	int Device::GetKeyScancode(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount ? m_KeyScancodes[key] : -1;
+	}
+
+	KeyCode Device::FindKeyByScancode(int scancode) const
+	{
+		auto it = m_ScancodeKeys.find(scancode);
+
+		return it != m_ScancodeKeys.end() ? it->second : KeyCode::Unknown;
+	}
+
+	KeyCode Device::FindKeyByName(std::string_view name) const
+	{
+		auto it = m_NamedKeys.find(name);
+
+		return it != m_NamedKeys.end() ? it->second : KeyCode::Unknown;
+	}
+
+	void Device::RefreshKeyboardLayout()
+	{
+		std::string arena;
+		arena.reserve(m_KeyNameArena.capacity() != 0 ? m_KeyNameArena.capacity() : 1024);
+
+		// Offsets into the arena, the views are created once it stops growing
+		std::array<std::pair<int, int>, KeyCount> names = {};
+		std::array<int, KeyCount> scancodes             = {};
+
+		// GLFW reports an error for the values in the gaps of the enum
+		scancodes.fill(-1);
+
+		for (int key = KeyCode::Space; key < KeyCount; key++)
+		{
+			if (!IsValidKeyCode(key))
+				continue;
+
+			scancodes[key] = glfwGetKeyScancode(key);
+
+			if (scancodes[key] == -1)
+				continue;
+
+			std::string_view name = GetNonPrintableKeyName((KeyCode)key);
+
+			// The returned string is valid only until the next call
+			if (const char* localized = glfwGetKeyName(key, 0))
+				name = localized;
+
+			names[key] = {(int)arena.size(), (int)name.size()};
+			arena.append(name);
+		}
+
+		if (arena == m_KeyNameArena && scancodes == m_KeyScancodes && !m_ScancodeKeys.empty())
+			return;
+
+		m_KeyNameArena = std::move(arena);
+		m_KeyScancodes = scancodes;
+
+		m_ScancodeKeys.clear();
+		m_NamedKeys.clear();
+
+		for (int key = 0; key < KeyCount; key++)
+		{
+			m_KeyNames[key] = std::string_view(m_KeyNameArena).substr(names[key].first, names[key].second);
+
+			if (m_KeyScancodes[key] != -1)
+				m_ScancodeKeys.emplace(m_KeyScancodes[key], (KeyCode)key);
+
+			// The first key wins, e.g. the digit row over the keypad
+			if (!m_KeyNames[key].empty())
+				m_NamedKeys.emplace(m_KeyNames[key], (KeyCode)key);
+		}
+
+		KeyboardLayoutChangedEvent.Invoke();
+	}
+
 	bool Device::IsVSyncEnabled() const
 	{
-		return m_VSync;
+		const Window* window = Window::FindInstance(glfwGetCurrentContext());
+
+		return window ? window->IsVSyncEnabled() : false;
 	}
 
 	void Device::SetVSync(bool enabled)
 	{
-		glfwSwapInterval(enabled ? 1 : 0);
+		if (!HasContext())
+			return;
+
+		Window* window = Window::FindInstance(glfwGetCurrentContext());
 
-		m_VSync = enabled;
+		ASSERT(window, "No window context is current!");
+
+		window->SetVSync(enabled ? VSyncMode::On : VSyncMode::Off);
 	}
 
-	void Device::PollEvents() const
+	void Device::PollEvents()
 	{
 		glfwPollEvents();
+
+		Window::FlushEventBatches();
+
+		UpdateCursorAnimations();
+
+		m_Scheduler.Update(glfwGetTime());
+
+		m_Commands.Execute();
+	}
+
+	void Device::WaitEvents()
+	{
+		WaitEvents(std::numeric_limits<double>::infinity());
+	}
+
+	void Device::WaitEvents(double timeout)
+	{
+		m_IsWaiting.store(true);
+
+		// Pairs with the fence in Post, the queue is checked only after the flag is visible to the producers
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// Tasks waiting for the next frame or a delay must not be blocked for longer
+		timeout = std::min(timeout, m_Scheduler.GetTimeUntilWake(glfwGetTime()));
+
+		// Commands posted before the flag was set would not wake the main thread up
+		if (!m_Commands.IsEmpty() || timeout <= 0.0)
+			glfwPollEvents();
+		else if (timeout == std::numeric_limits<double>::infinity())
+			glfwWaitEvents();
+		else
+			glfwWaitEventsTimeout(timeout);
+
+		m_IsWaiting.store(false);
+
+		Window::FlushEventBatches();
+
+		UpdateCursorAnimations();
+
+		m_Scheduler.Update(glfwGetTime());
+
+		m_Commands.Execute();
+	}
+
+	void Device::Post(CommandQueue::Command command)
+	{
+		m_Commands.Push(std::move(command));
+
+		// Pairs with the fence in WaitEvents: either the main thread sees the command, or this thread sees the flag
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		if (m_IsWaiting.load())
+			glfwPostEmptyEvent();
+	}
+
+	std::future<void> Device::PostWithCompletion(CommandQueue::Command command)
+	{
+		// std::function must be copyable, so the promise is shared
+		auto promise             = std::make_shared<std::promise<void>>();
+		std::future<void> future = promise->get_future();
+
+		Post([promise, command = std::move(command)]() {
+			command();
+
+			promise->set_value();
+		});
+
+		return future;
 	}
 
 	float Device::GetElapsedTime() const
@@ -113,4 +732,9 @@ namespace SW::Windowing
 		return (float)glfwGetTime();
 	}
 
+	double Device::GetPreciseElapsedTime() const
+	{
+		return glfwGetTime();
+	}
+
 } // namespace SW::Windowing
@@ -5,13 +5,31 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 #include <Eventing/Eventing.hpp>
 
+#include "Windowing/CommandQueue.hpp"
+#include "Windowing/Coroutine.hpp"
+#include "Windowing/IconSet.hpp"
+#include "Windowing/KeyCode.hpp"
+
 struct GLFWwindow;
 struct GLFWcursor;
+struct GLFWmonitor;
 
 namespace SW::Windowing
 {
+	class Window;
+	struct WindowSpecification;
 
 	enum class CursorMode
 	{
@@ -45,6 +63,20 @@ namespace SW::Windowing
 		Metal,
 	};
 
+	enum class Platform
+	{
+		// Let GLFW pick the platform (e.g. Wayland or X11 on Linux)
+		Any,
+
+		Win32,
+		Cocoa,
+		Wayland,
+		X11,
+
+		// No display, windows and monitors are emulated (e.g. for headless benchmarks)
+		Null,
+	};
+
 	struct CrosshairSpecification
 	{
 		// If not provided, the default cursor for that shape will be used.
@@ -61,6 +93,73 @@ namespace SW::Windowing
 		const char* CursorNotAllowedTexturePath       = nullptr;
 	};
 
+	// Identifier of a cursor created by Device::CreateCursor or Device::CreateAnimatedCursor
+	using CursorID = int;
+
+	constexpr CursorID InvalidCursor = -1;
+
+	struct CursorImage
+	{
+		// Encoded image (e.g. PNG) embedded in the application, decoded only once
+		EmbeddedIcon Image;
+
+		// Point of the image (in pixels, from the top-left corner) placed at the pointer position
+		int HotspotX = 0;
+		int HotspotY = 0;
+	};
+
+	struct AnimatedCursorSpecification
+	{
+		std::span<const CursorImage> Frames;
+
+		// Time (in seconds) each of the frames is displayed for
+		float FrameDuration = 0.1f;
+	};
+
+	struct VideoMode
+	{
+		int Width  = 0;
+		int Height = 0;
+
+		// In Hz
+		int RefreshRate = 0;
+
+		int RedBits   = 0;
+		int GreenBits = 0;
+		int BlueBits  = 0;
+	};
+
+	// Area of the monitor not occupied by global task bars or menu bars (in screen coordinates)
+	struct MonitorWorkArea
+	{
+		int X      = 0;
+		int Y      = 0;
+		int Width  = 0;
+		int Height = 0;
+	};
+
+	struct MonitorInfo
+	{
+		GLFWmonitor* Handle = nullptr;
+
+		std::string Name;
+
+		bool IsPrimary = false;
+
+		// Position of the monitor on the virtual desktop (in screen coordinates)
+		std::pair<int, int> Position;
+
+		MonitorWorkArea WorkArea;
+
+		// The ratio between the current DPI and the platform's default DPI {x, y}
+		std::pair<float, float> ContentScale;
+
+		VideoMode CurrentMode;
+
+		// All video modes supported by the monitor
+		std::vector<VideoMode> Modes;
+	};
+
 	struct DeviceSpecification
 	{
 #ifdef WINDOWING_OPENGL_CONTEXT
@@ -79,6 +178,9 @@ namespace SW::Windowing
 		// The API to use for rendering, very important to be set correctly!
 		ClientApi Api = ClientApi::OpenGL;
 
+		// The windowing platform to initialize
+		Platform Platform = Platform::Any;
+
 		// Path to the crosshair textures for different shapes (not required)
 		CrosshairSpecification CrosshairSpec;
 	};
@@ -92,27 +194,225 @@ namespace SW::Windowing
 		// in pixels {width, height}
 		std::pair<int, int> GetPrimaryMonitorSize() const;
 
+		// Cached monitors, the primary monitor is always the first one
+		const std::vector<MonitorInfo>& GetMonitors() const { return m_Monitors; }
+
+		const MonitorInfo& GetPrimaryMonitor() const;
+
+		// Returns the cached monitor with the given handle, nullptr if it is not connected
+		const MonitorInfo* FindMonitor(GLFWmonitor* handle) const;
+
+		// Returns the cached monitor containing the given point of the virtual desktop, nullptr if none
+		const MonitorInfo* FindMonitorAt(int x, int y) const;
+
+		// Queries all the monitors from the platform again.
+		// Called automatically on monitor (dis)connection, call it manually e.g. after a video mode change.
+		void RefreshMonitors();
+
 		GLFWcursor* GetCursorInstance(CursorShape shape) const;
 
+		// Creates the cursor once, the same image data always returns the same cursor.
+		// Cursors live as long as the device, InvalidCursor if the image can not be decoded.
+		CursorID CreateCursor(const CursorImage& image);
+
+		// Creates a cursor of all the frames at once, they are cycled during PollEvents/WaitEvents calls.
+		// Cached by every frame (data, size and hotspot) and the frame duration, cursors sharing the first frame
+		// differ. InvalidCursor if any of the frames can not be decoded.
+		CursorID CreateAnimatedCursor(const AnimatedCursorSpecification& spec);
+
+		// Returns the currently displayed frame of the cursor
+		GLFWcursor* GetCursorInstance(CursorID cursor) const;
+
+		bool IsAnimatedCursor(CursorID cursor) const;
+
+		// Used by the windows, makes the window follow the frames of the animated cursor
+		void AttachAnimatedCursor(GLFWwindow* window, CursorID cursor);
+		void DetachAnimatedCursor(GLFWwindow* window);
+
+		// Pre-creates hidden windows for AcquireWindow, so opening popups, tooltips and detached panels does not
+		// pay for the window and context creation. Pooled windows share their contexts.
+		void PrewarmWindows(const WindowSpecification& spec, int count);
+
+		// Returns a pooled window compatible with the specification (same titlebar and shared context), re-titled,
+		// resized and shown. Creates a new one if none is free. Full screen specifications are not supported.
+		Window* AcquireWindow(const WindowSpecification& spec);
+
+		// Hides the window and returns it to the pool instead of destroying it.
+		// Listeners added to the window's events must be removed by the caller before.
+		void ReleaseWindow(Window* window);
+
+		// Localized name of the key in the current keyboard layout (e.g. "z" for KeyCode::Y on a German layout),
+		// English name for the non-printable keys, empty if unknown. Valid until the next layout refresh.
+		std::string_view GetKeyName(KeyCode key) const;
+
+		// Localized name of the key with the platform-specific scancode
+		std::string_view GetScancodeName(int scancode) const { return GetKeyName(FindKeyByScancode(scancode)); }
+
+		// Platform-specific scancode of the key, -1 if the keyboard does not have it
+		int GetKeyScancode(KeyCode key) const;
+
+		// KeyCode::Unknown if not found
+		KeyCode FindKeyByScancode(int scancode) const;
+		KeyCode FindKeyByName(std::string_view name) const;
+
+		// Rebuilds the key tables from the platform keymap. Called automatically whenever a window gains focus
+		// (the layout is usually switched outside of the application), invokes KeyboardLayoutChangedEvent.
+		void RefreshKeyboardLayout();
+
+		// Returns the vsync state of the window whose context is current (see Window::IsVSyncEnabled)
 		bool IsVSyncEnabled() const;
 
-		// You must call this method after creating and defining a window as the current context
+		// Sets the vsync of the window whose context is current, prefer Window::SetVSync.
+		// You must call this method after creating and defining a window as the current context.
+		// Does nothing without a client API context (ClientApi::Vulkan).
 		void SetVSync(bool enabled);
 
-		// Enable the inputs and events managements with created windows
+		// Enable the inputs and events managements with created windows, executes the posted commands
 		// Call this every frame
-		void PollEvents() const;
+		void PollEvents();
+
+		// Same as PollEvents, but blocks until any event arrives or a command is posted
+		void WaitEvents();
+
+		// Same as WaitEvents, but blocks at most for the given time (in seconds)
+		void WaitEvents(double timeout);
+
+		// Queues the command to be executed on the main thread during the next PollEvents/WaitEvents call,
+		// wakes up the main thread if it is blocked in WaitEvents. Thread-safe, never blocks.
+		// Use it for all the main thread only calls (e.g. Window::SetTitle, Window::Show) from other threads.
+		void Post(CommandQueue::Command command);
+
+		// Same as Post, the returned future becomes ready once the command was executed
+		std::future<void> PostWithCompletion(CommandQueue::Command command);
+
+		// Runs the coroutine until its first suspension, the rest is driven by PollEvents/WaitEvents (see Task)
+		void Spawn(Task task) { m_Scheduler.Spawn(std::move(task)); }
+
+		TaskScheduler& GetScheduler() { return m_Scheduler; }
 
 		// Returns the elapsed time (in seconds) since the device startup
 		float GetElapsedTime() const;
 
+		// Same as GetElapsedTime, but keeps the full timer precision (e.g. for FrameStatistics)
+		double GetPreciseElapsedTime() const;
+
+		ClientApi GetClientApi() const { return m_Api; }
+
+		// Whether the windows are created with an OpenGL (ES) context, the other APIs create no context at all
+		bool HasContext() const { return m_Api == ClientApi::OpenGL || m_Api == ClientApi::OpenGLES; }
+
 	public:
-		static Eventing::Event<int, std::string> ErrorEvent;
+		// The description is valid only during the invocation, copy it to keep it
+		static Eventing::Event<int, std::string_view> ErrorEvent;
+
+		// Monitor events
+		Eventing::Event<const MonitorInfo&> MonitorConnectedEvent;
+		Eventing::Event<const MonitorInfo&> MonitorDisconnectedEvent;
+		Eventing::Event<> MonitorsChangedEvent;
+
+		// Invoked when a refresh finds the key names have changed
+		Eventing::Event<> KeyboardLayoutChangedEvent;
+
+	private:
+		void OnMonitorEvent(GLFWmonitor* monitor, int event);
+
+		// Creates a hidden window for the pool, sharing the context of the first pooled window
+		Window* CreatePooledWindow(const WindowSpecification& spec);
+
+		// Switches the frames of the animated cursors that are due and applies them to the attached windows
+		void UpdateCursorAnimations();
+
+	private:
+		struct CustomCursor
+		{
+			std::vector<GLFWcursor*> Frames;
+
+			float FrameDuration = 0.0f;
+
+			int CurrentFrame = 0;
+		};
+
+		// Identifies a custom cursor by all of its frames and the frame duration
+		struct CustomCursorKey
+		{
+			struct Frame
+			{
+				const uchar* Data = nullptr;
+				int Size          = 0;
+				int HotspotX      = 0;
+				int HotspotY      = 0;
+
+				bool operator==(const Frame& other) const = default;
+			};
+
+			std::vector<Frame> Frames;
+
+			float FrameDuration = 0.0f;
+
+			bool operator==(const CustomCursorKey& other) const = default;
+		};
+
+		struct CustomCursorKeyHash
+		{
+			size_t operator()(const CustomCursorKey& key) const;
+		};
+
+		struct PooledWindow
+		{
+			std::unique_ptr<Window> Instance;
+
+			// Creation-only hints, the rest of the specification is applied on acquisition
+			bool HasTitlebar = true;
+
+			// Requested context to share with, null for the pool's own share group
+			Window* SharedContext = nullptr;
+
+			bool IsAcquired = false;
+		};
+
+		struct AnimatedCursorWindow
+		{
+			CursorID Cursor = InvalidCursor;
+
+			// Frame last set to the window
+			int Frame = 0;
+		};
 
 	private:
-		bool m_VSync = true;
+		ClientApi m_Api;
 
 		std::unordered_map<CursorShape, GLFWcursor*> m_Cursors;
+
+		// Indexed by the CursorID
+		std::vector<CustomCursor> m_CustomCursors;
+
+		// Already created cursors by their frames and frame duration
+		std::unordered_map<CustomCursorKey, CursorID, CustomCursorKeyHash> m_CustomCursorIDs;
+
+		// Windows currently displaying an animated cursor
+		std::unordered_map<GLFWwindow*, AnimatedCursorWindow> m_AnimatedCursorWindows;
+
+		std::vector<PooledWindow> m_WindowPool;
+
+		// Keyboard layout tables, all the names are views into the single arena
+		std::string m_KeyNameArena;
+		std::array<std::string_view, KeyCount> m_KeyNames = {};
+		std::array<int, KeyCount> m_KeyScancodes          = {};
+		std::unordered_map<int, KeyCode> m_ScancodeKeys;
+		std::unordered_map<std::string_view, KeyCode> m_NamedKeys;
+
+		std::vector<MonitorInfo> m_Monitors;
+
+		CommandQueue m_Commands;
+
+		TaskScheduler m_Scheduler;
+
+		// Whether the main thread is (about to be) blocked in WaitEvents
+		std::atomic<bool> m_IsWaiting = false;
+
+	private:
+		// GLFW monitor callback is global, so only one device can receive it
+		static Device* s_INSTANCE;
 	};
 
 } // namespace SW::Windowing
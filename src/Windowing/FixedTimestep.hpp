@@ -0,0 +1,119 @@
+/**
+ * @file FixedTimestep.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "Windowing/Timestep.hpp"
+
+namespace SW::Windowing
+{
+
+	// Fixed-update clock, decouples the simulation rate from the render rate. Accumulates the frame times in double
+	// precision and tells how many fixed ticks to run, at most MaxSteps per frame (the time of the ticks above it is
+	// dropped, so a slow frame can not make the next one even slower).
+	class FixedTimestep
+	{
+	public:
+		FixedTimestep(double tickRate = 60.0, int maxSteps = 5)
+		{
+			SetTickRate(tickRate);
+			SetMaxSteps(maxSteps);
+		}
+
+		// Adds the frame ending at the given time (in seconds, e.g. Device::GetPreciseElapsedTime) and returns
+		// the number of ticks to run. The first call only starts the clock.
+		int Advance(double time)
+		{
+			const double frameTime = m_LastTime < 0.0 ? 0.0 : time - m_LastTime;
+
+			m_LastTime = time;
+
+			return AddFrameTime(frameTime);
+		}
+
+		// Same as Advance, but with the duration of the frame (in seconds)
+		int AddFrameTime(double frameTime)
+		{
+			m_Accumulator += std::max(frameTime, 0.0);
+
+			unsigned long long steps = (unsigned long long)(m_Accumulator / m_Step);
+
+			// The rounding errors must not leave the accumulator negative or at a whole step
+			m_Accumulator = std::clamp(m_Accumulator - (double)steps * m_Step, 0.0, std::nextafter(m_Step, 0.0));
+
+			if (steps > (unsigned long long)m_MaxSteps)
+			{
+				m_DroppedTickCount += steps - m_MaxSteps;
+				steps = m_MaxSteps;
+			}
+
+			m_LastFrameTickCount = (int)steps;
+			m_TickCount += steps;
+			m_FrameCount++;
+
+			return m_LastFrameTickCount;
+		}
+
+		// Forgets the accumulated time and the statistics, the next Advance call starts the clock again
+		void Reset()
+		{
+			m_Accumulator        = 0.0;
+			m_LastTime           = -1.0;
+			m_TickCount          = 0;
+			m_DroppedTickCount   = 0;
+			m_FrameCount         = 0;
+			m_LastFrameTickCount = 0;
+		}
+
+		// Duration of a single tick, pass it to every fixed update
+		Timestep GetStep() const { return (float)m_Step; }
+		double GetPreciseStep() const { return m_Step; }
+
+		double GetTickRate() const { return 1.0 / m_Step; }
+		void SetTickRate(double tickRate) { m_Step = 1.0 / std::max(tickRate, 1.0e-6); }
+
+		int GetMaxSteps() const { return m_MaxSteps; }
+		void SetMaxSteps(int maxSteps) { m_MaxSteps = std::max(maxSteps, 1); }
+
+		// Fraction of the next tick already accumulated, in range [0, 1). Render the state interpolated between
+		// the last two ticks by it.
+		float GetAlpha() const { return std::min((float)(m_Accumulator / m_Step), std::nextafter(1.0f, 0.0f)); }
+
+		// Total number of ticks run since the creation (or the last Reset call)
+		unsigned long long GetTickCount() const { return m_TickCount; }
+
+		// Ticks skipped by the MaxSteps limit, non-zero means the simulation could not keep up
+		unsigned long long GetDroppedTickCount() const { return m_DroppedTickCount; }
+
+		// Number of ticks the last frame ran
+		int GetLastFrameTickCount() const { return m_LastFrameTickCount; }
+
+		double GetAverageTicksPerFrame() const
+		{
+			return m_FrameCount > 0 ? (double)m_TickCount / (double)m_FrameCount : 0.0;
+		}
+
+	private:
+		double m_Step = 1.0 / 60.0;
+
+		// Time not consumed by the ticks yet, always less than a single step
+		double m_Accumulator = 0.0;
+
+		// Time of the last Advance call, negative if none
+		double m_LastTime = -1.0;
+
+		int m_MaxSteps = 5;
+
+		unsigned long long m_TickCount        = 0;
+		unsigned long long m_DroppedTickCount = 0;
+		unsigned long long m_FrameCount       = 0;
+
+		int m_LastFrameTickCount = 0;
+	};
+
+} // namespace SW::Windowing
@@ -0,0 +1,137 @@
+#include "FramePipeline.hpp"
+
+#include "Device.hpp"
+#include "Window.hpp"
+
+namespace SW::Windowing
+{
+
+	FramePipeline::FramePipeline(Device* device, Window* window, const FramePipelineSpecification& specification)
+	    : m_Device(device), m_Window(window), m_Input(window), m_Specification(specification),
+	      m_FramesInFlight(specification.FramesInFlight)
+	{
+		ASSERT(m_FramesInFlight >= 1, "At least one frame must be in flight!");
+		ASSERT(m_Specification.Simulate, "Simulate stage is required!");
+		ASSERT(m_Specification.Render, "Render stage is required!");
+
+		// One slot per frame in flight, the oldest one is presented before the next frame is sampled
+		m_Slots = std::make_unique<Slot[]>(m_FramesInFlight);
+
+		m_Worker = std::thread([this]() { SimulateFrames(); });
+	}
+
+	FramePipeline::~FramePipeline()
+	{
+		// The frames in flight are dropped, but their simulation must finish before the worker can be stopped
+		for (unsigned long long frame = m_NextPresentedFrame; frame < m_NextFrame; frame++)
+		{
+			std::atomic<SlotState>& state = m_Slots[frame % m_FramesInFlight].State;
+
+			state.wait(SlotState::Submitted, std::memory_order_acquire);
+		}
+
+		// The worker waits for the slot of the next frame, which is free
+		std::atomic<SlotState>& next = m_Slots[m_NextFrame % m_FramesInFlight].State;
+
+		next.store(SlotState::Stop, std::memory_order_release);
+		next.notify_one();
+
+		m_Worker.join();
+	}
+
+	void FramePipeline::RunFrame()
+	{
+		m_Device->PollEvents();
+
+		const InputSnapshot& snapshot = m_Input.PublishSnapshot();
+
+		// Promotes the pressed keys to held (so a press is in a single frame's snapshot) and resolves the claims
+		m_Input.UpdateKeysStateIfNecessary();
+
+		Slot& slot = m_Slots[m_NextFrame % m_FramesInFlight];
+
+		ASSERT(slot.State.load(std::memory_order_relaxed) == SlotState::Free, "Frame slot is still in flight!");
+
+		const double time = m_Device->GetPreciseElapsedTime();
+
+		slot.Frame.Index = m_NextFrame;
+		slot.Frame.Slot  = (int)(m_NextFrame % m_FramesInFlight);
+		slot.Frame.Time  = time;
+		slot.Frame.Delta = m_LastTime < 0.0 ? 0.0f : (float)(time - m_LastTime);
+		slot.Frame.Input = snapshot;
+
+		m_LastTime = time;
+
+		m_Input.ClearReleasedKeys();
+		m_Window->ClearTextInput();
+
+		if (m_Specification.Input)
+			m_Specification.Input(slot.Frame);
+
+		slot.State.store(SlotState::Submitted, std::memory_order_release);
+		slot.State.notify_one();
+
+		m_NextFrame++;
+
+		if (GetFramesInFlight() == m_FramesInFlight)
+			PresentOldestFrame();
+	}
+
+	void FramePipeline::Run()
+	{
+		while (!m_Window->ShouldClose())
+			RunFrame();
+
+		Flush();
+	}
+
+	void FramePipeline::Flush()
+	{
+		while (GetFramesInFlight() > 0)
+			PresentOldestFrame();
+	}
+
+	void FramePipeline::SimulateFrames()
+	{
+		for (unsigned long long frame = 0;; frame++)
+		{
+			Slot& slot = m_Slots[frame % m_FramesInFlight];
+
+			// With a single slot it may still hold the previous frame
+			SlotState state = slot.State.load(std::memory_order_acquire);
+
+			while (state != SlotState::Submitted && state != SlotState::Stop)
+			{
+				slot.State.wait(state, std::memory_order_acquire);
+				state = slot.State.load(std::memory_order_acquire);
+			}
+
+			if (state == SlotState::Stop)
+				return;
+
+			m_Specification.Simulate(slot.Frame);
+
+			slot.State.store(SlotState::Simulated, std::memory_order_release);
+			slot.State.notify_one();
+		}
+	}
+
+	void FramePipeline::PresentOldestFrame()
+	{
+		Slot& slot = m_Slots[m_NextPresentedFrame % m_FramesInFlight];
+
+		slot.State.wait(SlotState::Submitted, std::memory_order_acquire);
+
+		m_Specification.Render(slot.Frame);
+
+		m_Window->SwapBuffers();
+
+		if (m_Specification.Present)
+			m_Specification.Present(slot.Frame);
+
+		slot.State.store(SlotState::Free, std::memory_order_release);
+
+		m_NextPresentedFrame++;
+	}
+
+} // namespace SW::Windowing
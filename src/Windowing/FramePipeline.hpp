@@ -0,0 +1,131 @@
+/**
+ * @file FramePipeline.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "Windowing/InputManager.hpp"
+#include "Windowing/Timestep.hpp"
+
+namespace SW::Windowing
+{
+	class Device;
+	class Window;
+
+	// Everything a stage knows about its frame. Filled by the input stage, the simulate stage may write the rest of
+	// the per-frame data to the application's own storage indexed by Slot.
+	struct FrameContext
+	{
+		// Sequence number of the frame, starting from 0
+		unsigned long long Index = 0;
+
+		// Storage slot of the frame in range [0, FramePipeline::GetSlotCount()), reused once the frame is presented
+		int Slot = 0;
+
+		// Device time (in seconds) the frame's input was sampled at
+		double Time = 0.0;
+
+		// Time since the previous frame's input
+		Timestep Delta;
+
+		// Copy of the frame's input, unaffected by the later PublishSnapshot calls
+		InputSnapshot Input;
+	};
+
+	struct FramePipelineSpecification
+	{
+		// Frames submitted for simulation but not presented yet. 1 runs the stages serially (lowest latency),
+		// 2 simulates the next frame while the current one renders, more trade latency for throughput.
+		int FramesInFlight = 2;
+
+		// Main thread, right after the input is sampled (optional)
+		std::function<void(FrameContext&)> Input;
+
+		// Worker thread, in the frame order
+		std::function<void(FrameContext&)> Simulate;
+
+		// Main thread, once the frame's simulation is finished
+		std::function<void(const FrameContext&)> Render;
+
+		// Main thread, after the window's buffers are swapped (optional)
+		std::function<void(const FrameContext&)> Present;
+	};
+
+	// Main loop split into the input, simulate, render and present stages. The simulation runs on a dedicated
+	// worker thread, so frame N+1 is simulated while frame N renders on the main thread.
+	// Call RunFrame on the main thread in place of the PollEvents -> update -> render -> SwapBuffers loop.
+	class FramePipeline
+	{
+	public:
+		FramePipeline(Device* device, Window* window, const FramePipelineSpecification& specification);
+		~FramePipeline();
+
+		FramePipeline(const FramePipeline&)            = delete;
+		FramePipeline& operator=(const FramePipeline&) = delete;
+
+		// Samples the input of the next frame and submits it for simulation, then renders and presents the oldest
+		// frame if FramesInFlight frames are in flight (waiting for its simulation if necessary).
+		// The first FramesInFlight - 1 calls present nothing.
+		void RunFrame();
+
+		// Calls RunFrame until the window should close, then waits for the frames in flight
+		void Run();
+
+		// Waits for the simulation of all the frames in flight and renders and presents them
+		void Flush();
+
+		int GetSlotCount() const { return m_FramesInFlight; }
+
+		// Frames submitted for simulation but not presented yet
+		int GetFramesInFlight() const { return (int)(m_NextFrame - m_NextPresentedFrame); }
+
+	private:
+		enum class SlotState : int
+		{
+			Free,
+			Submitted,
+			Simulated,
+
+			// Tells the worker to finish
+			Stop,
+		};
+
+		struct alignas(64) Slot
+		{
+			std::atomic<SlotState> State = SlotState::Free;
+
+			FrameContext Frame;
+		};
+
+		void SimulateFrames();
+
+		void PresentOldestFrame();
+
+	private:
+		Device* m_Device = nullptr;
+		Window* m_Window = nullptr;
+
+		InputManager m_Input;
+
+		FramePipelineSpecification m_Specification;
+
+		int m_FramesInFlight = 0;
+
+		std::unique_ptr<Slot[]> m_Slots;
+
+		unsigned long long m_NextFrame          = 0;
+		unsigned long long m_NextPresentedFrame = 0;
+
+		// Time of the last frame's input, negative before the first frame
+		double m_LastTime = -1.0;
+
+		std::thread m_Worker;
+	};
+
+} // namespace SW::Windowing
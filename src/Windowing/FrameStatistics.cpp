@@ -0,0 +1,180 @@
+#include "FrameStatistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace SW::Windowing
+{
+
+	FrameStatistics::FrameStatistics(Timestep hitchBudget) : m_HitchBudget(hitchBudget)
+	{
+	}
+
+	void FrameStatistics::AddFrame(Timestep frameTime)
+	{
+		const float seconds = std::max(frameTime.GetSeconds(), 0.0f);
+		const int index     = GetIndex(m_TotalFrames);
+
+		if (m_Count == Capacity)
+		{
+			// The slot of the new frame holds the oldest one
+			const float evicted = m_Frames[index];
+
+			m_Sum -= evicted;
+			m_SumSquares -= (double)evicted * evicted;
+			m_Histogram[GetBucket(evicted)]--;
+
+			if (m_MaxQueueBegin != m_MaxQueueEnd && m_MaxQueue[GetIndex(m_MaxQueueBegin)] == m_TotalFrames - Capacity)
+				m_MaxQueueBegin++;
+		}
+		else
+		{
+			m_Count++;
+		}
+
+		m_Frames[index] = seconds;
+
+		m_Sum += seconds;
+		m_SumSquares += (double)seconds * seconds;
+		m_Histogram[GetBucket(seconds)]++;
+
+		// Shorter frames can never be the maximum again while this one is in the window
+		while (m_MaxQueueBegin != m_MaxQueueEnd &&
+		       m_Frames[GetIndex(m_MaxQueue[GetIndex(m_MaxQueueEnd - 1)])] <= seconds)
+		{
+			m_MaxQueueEnd--;
+		}
+
+		m_MaxQueue[GetIndex(m_MaxQueueEnd)] = m_TotalFrames;
+		m_MaxQueueEnd++;
+
+		m_TotalFrames++;
+
+		if (GetIndex(m_TotalFrames) == 0)
+			RecomputeSums();
+
+		if (seconds > m_HitchBudget.GetSeconds())
+		{
+			m_HitchCount++;
+
+			HitchEvent.Invoke(seconds);
+		}
+	}
+
+	void FrameStatistics::AddFrameTimestamp(double time)
+	{
+		if (m_LastTimestamp >= 0.0)
+			AddFrame((float)(time - m_LastTimestamp));
+
+		m_LastTimestamp = time;
+	}
+
+	void FrameStatistics::Reset()
+	{
+		m_Frames.fill(0.0f);
+		m_Histogram.fill(0);
+
+		m_Count         = 0;
+		m_TotalFrames   = 0;
+		m_HitchCount    = 0;
+		m_Sum           = 0.0;
+		m_SumSquares    = 0.0;
+		m_LastTimestamp = -1.0;
+		m_MaxQueueBegin = 0;
+		m_MaxQueueEnd   = 0;
+	}
+
+	Timestep FrameStatistics::GetLastFrameTime() const
+	{
+		return m_Count > 0 ? m_Frames[GetIndex(m_TotalFrames - 1)] : 0.0f;
+	}
+
+	Timestep FrameStatistics::GetMean() const
+	{
+		return m_Count > 0 ? (float)(m_Sum / m_Count) : 0.0f;
+	}
+
+	Timestep FrameStatistics::GetMax() const
+	{
+		if (m_MaxQueueBegin == m_MaxQueueEnd)
+			return 0.0f;
+
+		return m_Frames[GetIndex(m_MaxQueue[GetIndex(m_MaxQueueBegin)])];
+	}
+
+	double FrameStatistics::GetVariance() const
+	{
+		if (m_Count == 0)
+			return 0.0;
+
+		const double mean = m_Sum / m_Count;
+
+		return std::max(m_SumSquares / m_Count - mean * mean, 0.0);
+	}
+
+	Timestep FrameStatistics::GetPercentile(float percentile) const
+	{
+		if (m_Count == 0)
+			return 0.0f;
+
+		const int rank = std::clamp((int)std::ceil(percentile / 100.0f * m_Count), 1, m_Count);
+
+		int accumulated = 0;
+
+		for (int bucket = 0; bucket < BucketCount - 1; bucket++)
+		{
+			accumulated += m_Histogram[bucket];
+
+			if (accumulated >= rank)
+				return std::min((float)((bucket + 1) * PercentileResolution), GetMax().GetSeconds());
+		}
+
+		// Falls into the bucket of the longest frames
+		return GetMax();
+	}
+
+	void FrameStatistics::ExportCSV(std::ostream& stream) const
+	{
+		const unsigned long long oldest = m_TotalFrames - m_Count;
+
+		stream << "frame,milliseconds\n";
+
+		for (int i = 0; i < m_Count; i++)
+			stream << oldest + i << ',' << m_Frames[GetIndex(oldest + i)] * 1000.0f << '\n';
+	}
+
+	void FrameStatistics::ExportBinary(std::ostream& stream) const
+	{
+		const unsigned long long oldest = m_TotalFrames - m_Count;
+		const std::uint32_t count       = (std::uint32_t)m_Count;
+
+		stream.write("SWFS", 4);
+		stream.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+		for (int i = 0; i < m_Count; i++)
+			stream.write(reinterpret_cast<const char*>(&m_Frames[GetIndex(oldest + i)]), sizeof(float));
+	}
+
+	int FrameStatistics::GetBucket(float frameTime) const
+	{
+		return std::min((int)(frameTime / PercentileResolution), BucketCount - 1);
+	}
+
+	void FrameStatistics::RecomputeSums()
+	{
+		const unsigned long long oldest = m_TotalFrames - m_Count;
+
+		m_Sum        = 0.0;
+		m_SumSquares = 0.0;
+
+		for (int i = 0; i < m_Count; i++)
+		{
+			const double frameTime = m_Frames[GetIndex(oldest + i)];
+
+			m_Sum += frameTime;
+			m_SumSquares += frameTime * frameTime;
+		}
+	}
+
+} // namespace SW::Windowing
@@ -0,0 +1,116 @@
+/**
+ * @file FrameStatistics.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <array>
+#include <ostream>
+
+#include <Eventing/Eventing.hpp>
+
+#include "Windowing/Timestep.hpp"
+
+namespace SW::Windowing
+{
+
+	// Low-cost, always-on monitor of the recent frame times. Keeps a fixed-size ring of the last frames and
+	// updates all the rolling statistics in O(1) per frame, without any allocation.
+	class FrameStatistics
+	{
+	public:
+		// Number of the most recent frames the statistics are computed from
+		static constexpr int Capacity = 1024;
+
+		// Resolution (in seconds) of the percentiles
+		static constexpr double PercentileResolution = 0.0001;
+
+		// Number of percentile histogram buckets (up to 100 ms), the last one gathers all the longer frames
+		static constexpr int BucketCount = 1001;
+
+	public:
+		// Frames longer than the budget (in seconds) are reported as hitches
+		FrameStatistics(Timestep hitchBudget = 1.0f / 60.0f);
+
+		// Records the duration of the last frame
+		void AddFrame(Timestep frameTime);
+
+		// Records the frame ending at the given time (in seconds, e.g. Device::GetPreciseElapsedTime).
+		// The first call only starts the measurement.
+		void AddFrameTimestamp(double time);
+
+		// Forgets all the recorded frames and hitches
+		void Reset();
+
+		// Number of frames the statistics are currently computed from (up to Capacity)
+		int GetFrameCount() const { return m_Count; }
+
+		Timestep GetLastFrameTime() const;
+		Timestep GetMean() const;
+		Timestep GetMax() const;
+
+		// In seconds squared
+		double GetVariance() const;
+
+		// Percentile in range [0, 100] with PercentileResolution precision
+		Timestep GetPercentile(float percentile) const;
+
+		Timestep GetP50() const { return GetPercentile(50.0f); }
+		Timestep GetP95() const { return GetPercentile(95.0f); }
+		Timestep GetP99() const { return GetPercentile(99.0f); }
+
+		Timestep GetHitchBudget() const { return m_HitchBudget; }
+		void SetHitchBudget(Timestep budget) { m_HitchBudget = budget; }
+
+		// Total number of hitches since the creation (or the last Reset call)
+		unsigned long long GetHitchCount() const { return m_HitchCount; }
+
+		// Writes the recorded frames (oldest first) as "frame,milliseconds" lines
+		void ExportCSV(std::ostream& stream) const;
+
+		// Writes the recorded frames (oldest first) as: "SWFS" magic, uint32 frame count, float32 seconds per frame
+		void ExportBinary(std::ostream& stream) const;
+
+	public:
+		// Invoked with the frame time whenever a frame exceeds the hitch budget
+		Eventing::Event<Timestep> HitchEvent;
+
+	private:
+		// Index in the ring of the frame with the given sequence number
+		int GetIndex(unsigned long long frame) const { return (int)(frame % Capacity); }
+
+		int GetBucket(float frameTime) const;
+
+		// Recomputes the sums from scratch, so the floating point error does not accumulate
+		void RecomputeSums();
+
+	private:
+		Timestep m_HitchBudget;
+
+		// Ring of the recorded frame times (in seconds)
+		std::array<float, Capacity> m_Frames = {};
+
+		int m_Count = 0;
+
+		// Total number of recorded frames, used as the sequence number of the next frame
+		unsigned long long m_TotalFrames = 0;
+
+		unsigned long long m_HitchCount = 0;
+
+		double m_Sum        = 0.0;
+		double m_SumSquares = 0.0;
+
+		// Timestamp of the last AddFrameTimestamp call, negative if none
+		double m_LastTimestamp = -1.0;
+
+		std::array<int, BucketCount> m_Histogram = {};
+
+		// Monotonic queue of frame sequence numbers with decreasing frame times (front is the maximum)
+		std::array<unsigned long long, Capacity> m_MaxQueue = {};
+
+		unsigned long long m_MaxQueueBegin = 0;
+		unsigned long long m_MaxQueueEnd   = 0;
+	};
+
+} // namespace SW::Windowing
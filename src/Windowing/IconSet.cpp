@@ -0,0 +1,291 @@
+#include "IconSet.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+#include <GLFW/glfw3.h>
+#include <stb_image.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define WINDOWING_ICON_SSE2
+	#include <emmintrin.h>
+#endif
+
+namespace SW::Windowing
+{
+
+	// Identifies a set by how it was built and by all of its sources
+	struct IconSetKey
+	{
+		bool IsGenerated = false;
+
+		// Data pointer and size of every source image, in order
+		std::vector<std::pair<const uchar*, int>> Sources;
+
+		bool operator==(const IconSetKey& other) const = default;
+	};
+
+	struct IconSetKeyHash
+	{
+		size_t operator()(const IconSetKey& key) const
+		{
+			size_t hash = key.IsGenerated ? 1 : 0;
+
+			for (const auto& [data, size] : key.Sources)
+			{
+				hash = hash * 31 + std::hash<const uchar*>()(data);
+				hash = hash * 31 + (size_t)size;
+			}
+
+			return hash;
+		}
+	};
+
+	// Sets already built for the embedded data (icons are embedded, so the data outlives the cache)
+	static std::unordered_map<IconSetKey, std::shared_ptr<const IconSet>, IconSetKeyHash> s_ICON_SETS;
+
+	static IconSetKey MakeKey(bool isGenerated, std::span<const EmbeddedIcon> icons)
+	{
+		IconSetKey key;
+
+		key.IsGenerated = isGenerated;
+		key.Sources.reserve(icons.size());
+
+		for (const EmbeddedIcon& icon : icons)
+			key.Sources.emplace_back(icon.Data, icon.Size);
+
+		return key;
+	}
+
+	struct SourceImage
+	{
+		int Width  = 0;
+		int Height = 0;
+
+		// RGBA as floats in range [0, 255], color premultiplied by alpha
+		std::vector<float> Pixels;
+	};
+
+	static SourceImage Premultiply(const uchar* pixels, int width, int height)
+	{
+		SourceImage image;
+
+		image.Width  = width;
+		image.Height = height;
+		image.Pixels.resize((size_t)width * height * 4);
+
+		const size_t count = (size_t)width * height;
+
+#ifdef WINDOWING_ICON_SSE2
+		const __m128i zero     = _mm_setzero_si128();
+		const __m128 colorMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		const __m128 alphaOne  = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+		const __m128 inv255    = _mm_set1_ps(1.0f / 255.0f);
+
+		for (size_t i = 0; i < count; i++)
+		{
+			int packed;
+			std::copy_n(pixels + i * 4, 4, reinterpret_cast<uchar*>(&packed));
+
+			const __m128i bytes = _mm_cvtsi32_si128(packed);
+			const __m128i words = _mm_unpacklo_epi8(bytes, zero);
+			const __m128 pixel  = _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+
+			// {a, a, a, 1} / 255 for the color, 1 for the alpha itself
+			const __m128 alpha  = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128 factor = _mm_or_ps(_mm_and_ps(_mm_mul_ps(alpha, inv255), colorMask), alphaOne);
+
+			_mm_storeu_ps(&image.Pixels[i * 4], _mm_mul_ps(pixel, factor));
+		}
+#else
+		for (size_t i = 0; i < count; i++)
+		{
+			const float alpha = pixels[i * 4 + 3] / 255.0f;
+
+			image.Pixels[i * 4 + 0] = pixels[i * 4 + 0] * alpha;
+			image.Pixels[i * 4 + 1] = pixels[i * 4 + 1] * alpha;
+			image.Pixels[i * 4 + 2] = pixels[i * 4 + 2] * alpha;
+			image.Pixels[i * 4 + 3] = pixels[i * 4 + 3];
+		}
+#endif
+
+		return image;
+	}
+
+	// Box filter, every destination pixel is the average of the (premultiplied) source pixels it covers
+	static IconImage Downscale(const SourceImage& source, int width, int height)
+	{
+		IconImage image;
+
+		image.Width  = width;
+		image.Height = height;
+		image.Pixels.resize((size_t)width * height * 4);
+
+		for (int y = 0; y < height; y++)
+		{
+			const int sourceY0 = y * source.Height / height;
+			const int sourceY1 = std::max((y + 1) * source.Height / height, sourceY0 + 1);
+
+			for (int x = 0; x < width; x++)
+			{
+				const int sourceX0 = x * source.Width / width;
+				const int sourceX1 = std::max((x + 1) * source.Width / width, sourceX0 + 1);
+
+				const float weight = 1.0f / (float)((sourceX1 - sourceX0) * (sourceY1 - sourceY0));
+
+				uchar* out = &image.Pixels[((size_t)y * width + x) * 4];
+
+#ifdef WINDOWING_ICON_SSE2
+				__m128 sum = _mm_setzero_ps();
+
+				for (int sy = sourceY0; sy < sourceY1; sy++)
+				{
+					const float* row = &source.Pixels[((size_t)sy * source.Width) * 4];
+
+					for (int sx = sourceX0; sx < sourceX1; sx++)
+						sum = _mm_add_ps(sum, _mm_loadu_ps(row + sx * 4));
+				}
+
+				const __m128 average = _mm_mul_ps(sum, _mm_set1_ps(weight));
+
+				alignas(16) float channels[4];
+				_mm_store_ps(channels, average);
+
+				const float alpha = channels[3];
+
+				// Back to straight alpha, {255 / a, 255 / a, 255 / a, 1}
+				const float unpremultiply = alpha > 0.0f ? 255.0f / alpha : 0.0f;
+				const __m128 factor       = _mm_set_ps(1.0f, unpremultiply, unpremultiply, unpremultiply);
+
+				const __m128i rounded = _mm_cvtps_epi32(_mm_mul_ps(average, factor));
+				const __m128i words   = _mm_packs_epi32(rounded, rounded);
+				const int packed      = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+
+				std::copy_n(reinterpret_cast<const uchar*>(&packed), 4, out);
+#else
+				float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+				for (int sy = sourceY0; sy < sourceY1; sy++)
+				{
+					const float* row = &source.Pixels[((size_t)sy * source.Width) * 4];
+
+					for (int sx = sourceX0; sx < sourceX1; sx++)
+					{
+						for (int channel = 0; channel < 4; channel++)
+							sum[channel] += row[sx * 4 + channel];
+					}
+				}
+
+				const float alpha         = sum[3] * weight;
+				const float unpremultiply = alpha > 0.0f ? 255.0f / alpha : 0.0f;
+
+				for (int channel = 0; channel < 3; channel++)
+					out[channel] = (uchar)std::clamp(sum[channel] * weight * unpremultiply + 0.5f, 0.0f, 255.0f);
+
+				out[3] = (uchar)std::clamp(alpha + 0.5f, 0.0f, 255.0f);
+#endif
+			}
+		}
+
+		return image;
+	}
+
+	static bool Decode(const EmbeddedIcon& icon, IconImage& image)
+	{
+		int channels;
+
+		uchar* pixels = stbi_load_from_memory(icon.Data, icon.Size, &image.Width, &image.Height, &channels, 4);
+
+		if (pixels == nullptr)
+			return false;
+
+		image.Pixels.assign(pixels, pixels + (size_t)image.Width * image.Height * 4);
+
+		stbi_image_free(pixels);
+
+		return true;
+	}
+
+	std::shared_ptr<const IconSet> IconSet::Generate(const EmbeddedIcon& icon)
+	{
+		IconSetKey key = MakeKey(true, std::span<const EmbeddedIcon>(&icon, 1));
+
+		if (auto it = s_ICON_SETS.find(key); it != s_ICON_SETS.end())
+			return it->second;
+
+		IconImage original;
+
+		if (!Decode(icon, original))
+			return nullptr;
+
+		auto set = std::make_shared<IconSet>();
+
+		const int largestSide = std::max(original.Width, original.Height);
+
+		const SourceImage source = Premultiply(original.Pixels.data(), original.Width, original.Height);
+
+		for (const int size : GeneratedSizes)
+		{
+			// Upscaled images carry no additional detail, the window manager can do it as well
+			if (size >= largestSide)
+				break;
+
+			// Keep the aspect ratio, the longer side gets the size
+			const int width  = std::max(size * original.Width / largestSide, 1);
+			const int height = std::max(size * original.Height / largestSide, 1);
+
+			set->m_Images.push_back(Downscale(source, width, height));
+		}
+
+		set->m_Images.push_back(std::move(original));
+
+		s_ICON_SETS[std::move(key)] = set;
+
+		return set;
+	}
+
+	std::shared_ptr<const IconSet> IconSet::Load(std::span<const EmbeddedIcon> icons)
+	{
+		if (icons.empty())
+			return nullptr;
+
+		IconSetKey key = MakeKey(false, icons);
+
+		if (auto it = s_ICON_SETS.find(key); it != s_ICON_SETS.end())
+			return it->second;
+
+		auto set = std::make_shared<IconSet>();
+
+		for (const EmbeddedIcon& icon : icons)
+		{
+			IconImage image;
+
+			if (Decode(icon, image))
+				set->m_Images.push_back(std::move(image));
+		}
+
+		if (set->m_Images.empty())
+			return nullptr;
+
+		s_ICON_SETS[std::move(key)] = set;
+
+		return set;
+	}
+
+	void IconSet::Apply(GLFWwindow* window) const
+	{
+		std::vector<GLFWimage> images;
+		images.reserve(m_Images.size());
+
+		for (const IconImage& image : m_Images)
+		{
+			// GLFW copies the pixels, it never writes to them
+			images.push_back({image.Width, image.Height, const_cast<uchar*>(image.Pixels.data())});
+		}
+
+		glfwSetWindowIcon(window, (int)images.size(), images.data());
+	}
+
+} // namespace SW::Windowing
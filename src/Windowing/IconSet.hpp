@@ -0,0 +1,60 @@
+/**
+ * @file IconSet.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+struct GLFWwindow;
+
+namespace SW::Windowing
+{
+	using uchar = unsigned char;
+
+	struct EmbeddedIcon
+	{
+		// Embedded binary icon of the application.
+		const uchar* Data = nullptr;
+
+		// Number of embedded binary fragments.
+		const int Size = 0;
+	};
+
+	struct IconImage
+	{
+		int Width  = 0;
+		int Height = 0;
+
+		// RGBA, 8 bits per channel, not premultiplied
+		std::vector<uchar> Pixels;
+	};
+
+	// All the sizes of a window icon, passed to the window manager at once so it does not have to rescale them.
+	// Sets are cached by all of their embedded sources, so windows with the same icon share them without any work.
+	class IconSet
+	{
+	public:
+		// Sizes generated from a single source image (only the ones not larger than the source)
+		static constexpr std::array<int, 6> GeneratedSizes = {16, 24, 32, 48, 64, 256};
+
+		// Decodes the icon and downscales it to all the GeneratedSizes, nullptr if the icon can not be decoded
+		static std::shared_ptr<const IconSet> Generate(const EmbeddedIcon& icon);
+
+		// Decodes the pre-supplied sizes of an icon, nullptr if none of them can be decoded
+		static std::shared_ptr<const IconSet> Load(std::span<const EmbeddedIcon> icons);
+
+		// Sets all the images as the window's icon in a single call
+		void Apply(GLFWwindow* window) const;
+
+		const std::vector<IconImage>& GetImages() const { return m_Images; }
+
+	private:
+		std::vector<IconImage> m_Images;
+	};
+
+} // namespace SW::Windowing
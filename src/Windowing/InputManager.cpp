@@ -1,133 +1,216 @@
 #include "InputManager.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <GLFW/glfw3.h>
 
 namespace SW::Windowing
 {
 
-	InputManager::InputManager(Window* window) : m_Window(window)
+	// Compares everything except the version
+	static bool IsSameInput(const InputSnapshot& first, const InputSnapshot& second)
+	{
+		return first.KeysDown == second.KeysDown && first.KeysPressed == second.KeysPressed &&
+		       first.KeysReleased == second.KeysReleased && first.MouseButtonsDown == second.MouseButtonsDown &&
+		       first.MouseButtonsPressed == second.MouseButtonsPressed &&
+		       first.MouseButtonsReleased == second.MouseButtonsReleased &&
+		       first.MousePosition == second.MousePosition && first.MouseDelta == second.MouseDelta &&
+		       first.Scroll == second.Scroll && first.GetText() == second.GetText();
+	}
+
+	struct InputManager::State
+	{
+		State(Window* window);
+		~State();
+
+		// Updates the state of the specified key.
+		void UpdateKeyState(KeyCode code, ClickableState state);
+
+		// Updates the state of the specified mouse button.
+		void UpdateMouseState(MouseCode code, ClickableState state);
+
+		Window* Owner = nullptr;
+
+		Eventing::ListenerID KeyPressedListener;
+		Eventing::ListenerID KeyReleasedListener;
+		Eventing::ListenerID KeyRepeatListener;
+
+		Eventing::ListenerID MouseButtonPressedListener;
+		Eventing::ListenerID MouseButtonReleasedListener;
+
+		Eventing::ListenerID CursorMoveListener;
+		Eventing::ListenerID MouseScrollWheelListener;
+
+		// The cached states of the keys, a key is in at most one of them (none means ClickableState::None)
+		KeyMask KeysPressed;
+		KeyMask KeysHeld;
+		KeyMask KeysReleased;
+
+		// The cached states of the mouse buttons
+		MouseButtonMask MouseButtonsPressed;
+		MouseButtonMask MouseButtonsHeld;
+		MouseButtonMask MouseButtonsReleased;
+
+		std::pair<float, float> MousePosition;
+
+		// Scroll accumulated since the last published snapshot
+		std::pair<float, float> Scroll;
+
+		// Ring of the snapshots, the front one is readable and the next publish writes to the one after it. Three, so
+		// a snapshot obtained right before a publish is still left intact by the publish after it.
+		std::array<InputSnapshot, 3> Snapshots;
+		std::atomic<int> FrontSnapshot = 0;
+
+		// Input context stack, the top one is the last
+		std::vector<InputContext*> Contexts;
+	};
+
+	std::unordered_map<Window*, std::weak_ptr<InputManager::State>> InputManager::s_STATES;
+
+	InputManager::State::State(Window* window) : Owner(window)
 	{
-		m_KeyPressedListener = m_Window->KeyPressedEvent +=
+		KeyPressedListener = Owner->KeyPressedEvent +=
 		    [this](KeyCode keyCode) { UpdateKeyState(keyCode, ClickableState::Pressed); };
 
-		m_KeyReleasedListener = m_Window->KeyReleasedEvent +=
+		KeyReleasedListener = Owner->KeyReleasedEvent +=
 		    [this](KeyCode keyCode) { UpdateKeyState(keyCode, ClickableState::Released); };
 
-		m_KeyRepeatListener = m_Window->KeyRepeatEvent +=
+		KeyRepeatListener = Owner->KeyRepeatEvent +=
 		    [this](KeyCode keyCode) { UpdateKeyState(keyCode, ClickableState::Repeated); };
 
-		m_MouseButtonPressedListener = m_Window->MouseButtonPressedEvent +=
-		    [this](MouseCode mouseCode) { UpdateMouseState(mouseCode, ClickableState::Repeated); };
+		MouseButtonPressedListener = Owner->MouseButtonPressedEvent +=
+		    [this](MouseCode mouseCode) { UpdateMouseState(mouseCode, ClickableState::Pressed); };
+
+		MouseButtonReleasedListener = Owner->MouseButtonReleasedEvent +=
+		    [this](MouseCode mouseCode) { UpdateMouseState(mouseCode, ClickableState::Released); };
+
+		CursorMoveListener = Owner->CursorMoveEvent += [this](float x, float y) { MousePosition = {x, y}; };
+
+		MouseScrollWheelListener = Owner->MouseScrollWheelEvent += [this](float xOffset, float yOffset) {
+			Scroll.first += xOffset;
+			Scroll.second += yOffset;
+		};
+
+		double x, y;
+		glfwGetCursorPos(Owner->GetWindowHandle(), &x, &y);
+
+		MousePosition = {(float)x, (float)y};
 
-		m_MouseButtonReleasedListener = m_Window->MouseButtonReleasedEvent +=
-		    [this](MouseCode mouseCode) { UpdateMouseState(mouseCode, ClickableState::Repeated); };
+		for (InputSnapshot& snapshot : Snapshots)
+			snapshot.MousePosition = MousePosition;
 	}
 
-	InputManager::~InputManager()
+	InputManager::State::~State()
 	{
-		m_Window->KeyPressedEvent -= m_KeyPressedListener;
-		m_Window->KeyReleasedEvent -= m_KeyReleasedListener;
-		m_Window->KeyRepeatEvent -= m_KeyRepeatListener;
-		m_Window->MouseButtonPressedEvent -= m_MouseButtonPressedListener;
-		m_Window->MouseButtonReleasedEvent -= m_MouseButtonReleasedListener;
+		ASSERT(Contexts.empty(), "Input contexts must be popped before the input managers are destroyed!");
+
+		Owner->KeyPressedEvent -= KeyPressedListener;
+		Owner->KeyReleasedEvent -= KeyReleasedListener;
+		Owner->KeyRepeatEvent -= KeyRepeatListener;
+		Owner->MouseButtonPressedEvent -= MouseButtonPressedListener;
+		Owner->MouseButtonReleasedEvent -= MouseButtonReleasedListener;
+		Owner->CursorMoveEvent -= CursorMoveListener;
+		Owner->MouseScrollWheelEvent -= MouseScrollWheelListener;
 	}
 
-	void InputManager::UpdateKeysStateIfNecessary()
+	void InputManager::State::UpdateKeyState(KeyCode code, ClickableState state)
 	{
-		for (auto& [code, state] : m_KeyStates)
-		{
-			if (state == ClickableState::Pressed)
-			{
-				state = ClickableState::Repeated;
-			}
-		}
+		// GLFW reports unknown keys as -1
+		if (code < 0 || code >= KeyCount)
+			return;
 
-		for (auto& [code, state] : m_MouseStates)
-		{
-			if (state == ClickableState::Pressed)
-			{
-				state = ClickableState::Repeated;
-			}
-		}
+		KeysPressed.set(code, state == ClickableState::Pressed);
+		KeysHeld.set(code, state == ClickableState::Repeated);
+		KeysReleased.set(code, state == ClickableState::Released);
 	}
 
-	void InputManager::ClearReleasedKeys()
+	void InputManager::State::UpdateMouseState(MouseCode code, ClickableState state)
 	{
-		for (auto& [code, state] : m_KeyStates)
-		{
-			if (state == ClickableState::Released)
-			{
-				state = ClickableState::None;
-			}
-		}
+		if (code < 0 || code >= MouseButtonCount)
+			return;
+
+		MouseButtonsPressed.set(code, state == ClickableState::Pressed);
+		MouseButtonsHeld.set(code, state == ClickableState::Repeated);
+		MouseButtonsReleased.set(code, state == ClickableState::Released);
+	}
+
+	InputManager::InputManager(Window* window) : m_Window(window)
+	{
+		if (auto it = s_STATES.find(window); it != s_STATES.end())
+			m_State = it->second.lock();
 
-		for (auto& [code, state] : m_MouseStates)
+		if (!m_State)
 		{
-			if (state == ClickableState::Released)
-			{
-				state = ClickableState::None;
-			}
+			m_State          = std::make_shared<State>(window);
+			s_STATES[window] = m_State;
 		}
 	}
 
-	bool InputManager::IsKeyPressed(KeyCode key) const
+	InputManager::~InputManager()
+	{
+		// The state is destroyed with the last manager of the window
+		if (m_State.use_count() == 1)
+			s_STATES.erase(m_Window);
+	}
+
+	void InputManager::UpdateKeysStateIfNecessary()
 	{
-		auto val = m_KeyStates.find(key);
+		ResolveContexts();
 
-		return val == m_KeyStates.end() ? false : val->second == ClickableState::Pressed;
+		m_State->KeysHeld |= m_State->KeysPressed;
+		m_State->KeysPressed.reset();
+
+		m_State->MouseButtonsHeld |= m_State->MouseButtonsPressed;
+		m_State->MouseButtonsPressed.reset();
 	}
 
-	bool InputManager::IsKeyHeld(KeyCode key) const
+	void InputManager::ClearReleasedKeys()
 	{
-		auto val = m_KeyStates.find(key);
+		m_State->KeysReleased.reset();
+		m_State->MouseButtonsReleased.reset();
+	}
 
-		return val == m_KeyStates.end() ? false : val->second == ClickableState::Repeated;
+	bool InputManager::IsKeyPressed(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount && m_State->KeysPressed.test(key);
 	}
 
-	bool InputManager::IsKeyDown(KeyCode key) const
+	bool InputManager::IsKeyHeld(KeyCode key) const
 	{
-		auto val = m_KeyStates.find(key);
+		return key >= 0 && key < KeyCount && m_State->KeysHeld.test(key);
+	}
 
-		return val == m_KeyStates.end()
-		           ? false
-		           : (val->second == ClickableState::Pressed || val->second == ClickableState::Repeated);
+	bool InputManager::IsKeyDown(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount && (m_State->KeysPressed.test(key) || m_State->KeysHeld.test(key));
 	}
 
 	bool InputManager::IsKeyReleased(KeyCode key) const
 	{
-		auto val = m_KeyStates.find(key);
-
-		return val == m_KeyStates.end() ? false : val->second == ClickableState::Released;
+		return key >= 0 && key < KeyCount && m_State->KeysReleased.test(key);
 	}
 
 	bool InputManager::IsMouseButtonPressed(MouseCode button) const
 	{
-		auto val = m_MouseStates.find(button);
-
-		return val == m_MouseStates.end() ? false : val->second == ClickableState::Pressed;
+		return button >= 0 && button < MouseButtonCount && m_State->MouseButtonsPressed.test(button);
 	}
 
 	bool InputManager::IsMouseButtonHeld(MouseCode button) const
 	{
-		auto val = m_MouseStates.find(button);
-
-		return val == m_MouseStates.end() ? false : val->second == ClickableState::Repeated;
+		return button >= 0 && button < MouseButtonCount && m_State->MouseButtonsHeld.test(button);
 	}
 
 	bool InputManager::IsMouseButtonDown(MouseCode button) const
 	{
-		auto val = m_MouseStates.find(button);
-
-		return val == m_MouseStates.end()
-		           ? false
-		           : (val->second == ClickableState::Pressed || val->second == ClickableState::Repeated);
+		return button >= 0 && button < MouseButtonCount &&
+		       (m_State->MouseButtonsPressed.test(button) || m_State->MouseButtonsHeld.test(button));
 	}
 
 	bool InputManager::IsMouseButtonReleased(MouseCode button) const
 	{
-		auto val = m_MouseStates.find(button);
-
-		return val == m_MouseStates.end() ? false : val->second == ClickableState::Released;
+		return button >= 0 && button < MouseButtonCount && m_State->MouseButtonsReleased.test(button);
 	}
 
 	std::pair<float, float> InputManager::GetMousePosition()
@@ -143,14 +226,205 @@ namespace SW::Windowing
 		glfwSetCursorPos(m_Window->GetWindowHandle(), (double)position.first, (double)position.second);
 	}
 
-	void InputManager::UpdateKeyState(KeyCode code, ClickableState state)
+	const InputSnapshot& InputManager::PublishSnapshot()
+	{
+		const int front           = m_State->FrontSnapshot.load(std::memory_order_relaxed);
+		const InputSnapshot& last = m_State->Snapshots[front];
+
+		// Readers of the front and the previous snapshot may still run, the oldest one was released a frame ago
+		const int back      = (front + 1) % (int)m_State->Snapshots.size();
+		InputSnapshot& next = m_State->Snapshots[back];
+
+		next.KeysDown     = m_State->KeysPressed | m_State->KeysHeld;
+		next.KeysPressed  = m_State->KeysPressed;
+		next.KeysReleased = m_State->KeysReleased;
+
+		next.MouseButtonsDown     = m_State->MouseButtonsPressed | m_State->MouseButtonsHeld;
+		next.MouseButtonsPressed  = m_State->MouseButtonsPressed;
+		next.MouseButtonsReleased = m_State->MouseButtonsReleased;
+
+		next.MousePosition = m_State->MousePosition;
+		next.MouseDelta    = {m_State->MousePosition.first - last.MousePosition.first,
+		                      m_State->MousePosition.second - last.MousePosition.second};
+		next.Scroll        = m_State->Scroll;
+
+		const std::string_view text = m_Window->GetTextInput();
+
+		size_t textLength = std::min(text.size(), (size_t)InputSnapshot::TextCapacity);
+
+		// Truncated text must not end with a split codepoint, back up over its continuation bytes
+		if (textLength < text.size())
+		{
+			while (textLength > 0 && ((unsigned char)text[textLength] & 0xC0) == 0x80)
+				textLength--;
+		}
+
+		next.TextLength = (int)textLength;
+		std::memcpy(next.Text.data(), text.data(), next.TextLength);
+
+		next.Version = IsSameInput(next, last) ? last.Version : last.Version + 1;
+
+		m_State->Scroll = {0.0f, 0.0f};
+
+		m_State->FrontSnapshot.store(back, std::memory_order_release);
+
+		return next;
+	}
+
+	const InputSnapshot& InputManager::GetSnapshot() const
+	{
+		return m_State->Snapshots[m_State->FrontSnapshot.load(std::memory_order_acquire)];
+	}
+
+	void InputManager::PushContext(InputContext& context)
+	{
+		ASSERT(!context.IsActive(), "Input context is already pushed!");
+
+		context.m_State = m_State.get();
+		context.m_Index = (int)m_State->Contexts.size();
+
+		m_State->Contexts.push_back(&context);
+
+		ResolveContexts();
+	}
+
+	void InputManager::PopContext(InputContext& context)
+	{
+		std::vector<InputContext*>& contexts = m_State->Contexts;
+
+		const bool isPushed = context.m_State == m_State.get() && context.m_Index >= 0 &&
+		                      context.m_Index < (int)contexts.size() && contexts[context.m_Index] == &context;
+
+		ASSERT(isPushed, "Input context is not pushed on this window!");
+
+		if (!isPushed)
+			return;
+
+		contexts.erase(contexts.begin() + context.m_Index);
+
+		for (int i = context.m_Index; i < (int)contexts.size(); i++)
+			contexts[i]->m_Index = i;
+
+		context.m_State = nullptr;
+
+		ResolveContexts();
+	}
+
+	void InputManager::ResolveContexts()
+	{
+		KeyMask availableKeys;
+		MouseButtonMask availableMouseButtons;
+
+		availableKeys.set();
+		availableMouseButtons.set();
+
+		for (auto it = m_State->Contexts.rbegin(); it != m_State->Contexts.rend(); ++it)
+		{
+			InputContext* context = *it;
+
+			context->m_VisibleKeys         = availableKeys;
+			context->m_VisibleMouseButtons = availableMouseButtons;
+
+			availableKeys &= ~context->m_ClaimedKeys;
+			availableMouseButtons &= ~context->m_ClaimedMouseButtons;
+		}
+	}
+
+	void InputContext::ClaimKey(KeyCode key)
+	{
+		if (key >= 0 && key < KeyCount)
+			m_ClaimedKeys.set(key);
+	}
+
+	void InputContext::UnclaimKey(KeyCode key)
+	{
+		if (key >= 0 && key < KeyCount)
+			m_ClaimedKeys.reset(key);
+	}
+
+	void InputContext::ClaimMouseButton(MouseCode button)
+	{
+		if (button >= 0 && button < MouseButtonCount)
+			m_ClaimedMouseButtons.set(button);
+	}
+
+	void InputContext::UnclaimMouseButton(MouseCode button)
+	{
+		if (button >= 0 && button < MouseButtonCount)
+			m_ClaimedMouseButtons.reset(button);
+	}
+
+	void InputContext::ClaimAll()
+	{
+		m_ClaimedKeys.set();
+		m_ClaimedMouseButtons.set();
+	}
+
+	void InputContext::UnclaimAll()
+	{
+		m_ClaimedKeys.reset();
+		m_ClaimedMouseButtons.reset();
+	}
+
+	void InputContext::ConsumeKey(KeyCode key)
+	{
+		if (m_State == nullptr || key < 0 || key >= KeyCount)
+			return;
+
+		for (int i = 0; i < m_Index; i++)
+			m_State->Contexts[i]->m_VisibleKeys.reset(key);
+	}
+
+	void InputContext::ConsumeMouseButton(MouseCode button)
+	{
+		if (m_State == nullptr || button < 0 || button >= MouseButtonCount)
+			return;
+
+		for (int i = 0; i < m_Index; i++)
+			m_State->Contexts[i]->m_VisibleMouseButtons.reset(button);
+	}
+
+	bool InputContext::IsKeyPressed(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount && m_VisibleKeys.test(key) && m_State->KeysPressed.test(key);
+	}
+
+	bool InputContext::IsKeyHeld(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount && m_VisibleKeys.test(key) && m_State->KeysHeld.test(key);
+	}
+
+	bool InputContext::IsKeyDown(KeyCode key) const
+	{
+		return IsKeyPressed(key) || IsKeyHeld(key);
+	}
+
+	bool InputContext::IsKeyReleased(KeyCode key) const
+	{
+		return key >= 0 && key < KeyCount && m_VisibleKeys.test(key) && m_State->KeysReleased.test(key);
+	}
+
+	bool InputContext::IsMouseButtonPressed(MouseCode button) const
+	{
+		return button >= 0 && button < MouseButtonCount && m_VisibleMouseButtons.test(button) &&
+		       m_State->MouseButtonsPressed.test(button);
+	}
+
+	bool InputContext::IsMouseButtonHeld(MouseCode button) const
+	{
+		return button >= 0 && button < MouseButtonCount && m_VisibleMouseButtons.test(button) &&
+		       m_State->MouseButtonsHeld.test(button);
+	}
+
+	bool InputContext::IsMouseButtonDown(MouseCode button) const
 	{
-		m_KeyStates[code] = state;
+		return IsMouseButtonPressed(button) || IsMouseButtonHeld(button);
 	}
 
-	void InputManager::UpdateMouseState(MouseCode code, ClickableState state)
+	bool InputContext::IsMouseButtonReleased(MouseCode button) const
 	{
-		m_MouseStates[code] = state;
+		return button >= 0 && button < MouseButtonCount && m_VisibleMouseButtons.test(button) &&
+		       m_State->MouseButtonsReleased.test(button);
 	}
 
 } // namespace SW::Windowing
@@ -5,7 +5,12 @@
  */
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
 
 #include <Eventing/Eventing.hpp>
 
@@ -30,12 +35,78 @@ namespace SW::Windowing
 		None
 	};
 
+	// Number of the mouse button codes
+	constexpr int MouseButtonCount = MouseCode::ButtonLast + 1;
+
+	using KeyMask         = std::bitset<KeyCount>;
+	using MouseButtonMask = std::bitset<MouseButtonCount>;
+
+	// Immutable, compact input state of a single frame, safe to read from any number of threads (see
+	// InputManager::GetSnapshot for how long a published one stays intact)
+	struct InputSnapshot
+	{
+		// Maximum number of bytes of the frame's text kept in the snapshot
+		static constexpr int TextCapacity = 128;
+
+		// Changes only if the input differs from the previous snapshot, use it to skip work
+		unsigned long long Version = 0;
+
+		// Pressed or held down
+		KeyMask KeysDown;
+		// Pressed during the frame
+		KeyMask KeysPressed;
+		// Released during the frame
+		KeyMask KeysReleased;
+
+		MouseButtonMask MouseButtonsDown;
+		MouseButtonMask MouseButtonsPressed;
+		MouseButtonMask MouseButtonsReleased;
+
+		std::pair<float, float> MousePosition;
+
+		// Mouse movement since the previous snapshot
+		std::pair<float, float> MouseDelta;
+
+		// Scroll wheel offset accumulated during the frame
+		std::pair<float, float> Scroll;
+
+		// UTF-8 text typed during the frame (truncated to TextCapacity bytes, at a codepoint boundary)
+		std::array<char, TextCapacity> Text = {};
+		int TextLength                      = 0;
+
+		std::string_view GetText() const { return {Text.data(), (size_t)TextLength}; }
+
+		bool IsKeyDown(KeyCode key) const { return key >= 0 && key < KeyCount && KeysDown.test(key); }
+		bool IsKeyPressed(KeyCode key) const { return key >= 0 && key < KeyCount && KeysPressed.test(key); }
+		bool IsKeyReleased(KeyCode key) const { return key >= 0 && key < KeyCount && KeysReleased.test(key); }
+
+		bool IsMouseButtonDown(MouseCode button) const
+		{
+			return button >= 0 && button < MouseButtonCount && MouseButtonsDown.test(button);
+		}
+		bool IsMouseButtonPressed(MouseCode button) const
+		{
+			return button >= 0 && button < MouseButtonCount && MouseButtonsPressed.test(button);
+		}
+		bool IsMouseButtonReleased(MouseCode button) const
+		{
+			return button >= 0 && button < MouseButtonCount && MouseButtonsReleased.test(button);
+		}
+	};
+
+	class InputContext;
+
+	// All the input managers of a window share a single input state, the window events are received only once.
+	// The per-frame calls are idempotent, so any of the managers can make them (PublishSnapshot once per frame).
 	class InputManager
 	{
 	public:
 		InputManager(Window* window);
 		~InputManager();
 
+		InputManager(const InputManager&)            = delete;
+		InputManager& operator=(const InputManager&) = delete;
+
 		// Update pressed keys state to held if pressed for one frame. Updates the state faster that GLFW wait after
 		// press.
 		// Be aware that this function should be called at the beginning of the frame.
@@ -72,28 +143,94 @@ namespace SW::Windowing
 		std::pair<float, float> GetMousePosition();
 		void SetMousePosition(const std::pair<float, float>& position);
 
-	private:
-		// Updates the state of the specified key.
-		void UpdateKeyState(KeyCode code, ClickableState state);
+		// Publishes the current input as the new snapshot, call it on the main thread at the frame boundary
+		// (after PollEvents, before UpdateKeysStateIfNecessary/ClearReleasedKeys and Window::ClearTextInput).
+		const InputSnapshot& PublishSnapshot();
+
+		// The last published snapshot, lock-free and safe to read from any number of threads within its lifetime.
+		// The returned snapshot is left intact by the next two PublishSnapshot calls, so a reader has at least one
+		// whole frame after the next publish to finish with it. Copy it to keep it longer, there is no check
+		// detecting a snapshot overwritten while it is read.
+		const InputSnapshot& GetSnapshot() const;
+
+		// Puts the context on top of the window's context stack (e.g. UI over the game), the context must be popped
+		// before the last input manager of the window is destroyed
+		void PushContext(InputContext& context);
 
-		// Updates the state of the specified mouse button.
-		void UpdateMouseState(MouseCode code, ClickableState state);
+		// Removes the context from the stack, not necessarily the top one
+		void PopContext(InputContext& context);
 
 	private:
+		// Computes what each of the contexts sees from the claims of the contexts above it
+		void ResolveContexts();
+
+	private:
+		friend class InputContext;
+
+		// Defined in the source file, shared by all the input managers of the window
+		struct State;
+
 		Window* m_Window = nullptr;
 
-		Eventing::ListenerID m_KeyPressedListener;
-		Eventing::ListenerID m_KeyReleasedListener;
-		Eventing::ListenerID m_KeyRepeatListener;
+		std::shared_ptr<State> m_State;
 
-		Eventing::ListenerID m_MouseButtonPressedListener;
-		Eventing::ListenerID m_MouseButtonReleasedListener;
+	private:
+		static std::unordered_map<Window*, std::weak_ptr<State>> s_STATES;
+	};
+
+	// Layer of the input routing (e.g. UI, overlay, game) pushed on the window's InputManager.
+	// Keys and mouse buttons claimed by a context are invisible to the contexts below it. Claims are resolved once
+	// per frame (in UpdateKeysStateIfNecessary), so the queries are single bit tests with no event fan-out.
+	class InputContext
+	{
+	public:
+		void ClaimKey(KeyCode key);
+		void UnclaimKey(KeyCode key);
+		void ClaimKeys(const KeyMask& keys) { m_ClaimedKeys |= keys; }
+
+		void ClaimMouseButton(MouseCode button);
+		void UnclaimMouseButton(MouseCode button);
+		void ClaimMouseButtons(const MouseButtonMask& buttons) { m_ClaimedMouseButtons |= buttons; }
+
+		// Claims all the keys and mouse buttons (e.g. a modal dialog)
+		void ClaimAll();
+		void UnclaimAll();
+
+		const KeyMask& GetClaimedKeys() const { return m_ClaimedKeys; }
+		const MouseButtonMask& GetClaimedMouseButtons() const { return m_ClaimedMouseButtons; }
+
+		// Hides the key or mouse button from the contexts below until the next resolution (e.g. a click handled
+		// by the UI). Only affects the contexts that have not read it yet, so consume before they update.
+		void ConsumeKey(KeyCode key);
+		void ConsumeMouseButton(MouseCode button);
+
+		// Same as the InputManager queries, but false for the keys and buttons claimed by the contexts above
+		bool IsKeyPressed(KeyCode key) const;
+		bool IsKeyHeld(KeyCode key) const;
+		bool IsKeyDown(KeyCode key) const;
+		bool IsKeyReleased(KeyCode key) const;
+
+		bool IsMouseButtonPressed(MouseCode button) const;
+		bool IsMouseButtonHeld(MouseCode button) const;
+		bool IsMouseButtonDown(MouseCode button) const;
+		bool IsMouseButtonReleased(MouseCode button) const;
+
+		// Whether the context is pushed on an input manager
+		bool IsActive() const { return m_State != nullptr; }
 
 	private:
-		// The cached states of the keys
-		std::map<KeyCode, ClickableState> m_KeyStates;
+		friend class InputManager;
+
+		InputManager::State* m_State = nullptr;
+
+		// Position in the stack, 0 is the bottom
+		int m_Index = 0;
+
+		KeyMask m_ClaimedKeys;
+		MouseButtonMask m_ClaimedMouseButtons;
 
-		// The cached states of the mouse buttons
-		std::map<MouseCode, ClickableState> m_MouseStates;
+		// Not claimed by any of the contexts above
+		KeyMask m_VisibleKeys;
+		MouseButtonMask m_VisibleMouseButtons;
 	};
 } // namespace SW::Windowing
@@ -10,6 +10,8 @@ namespace SW::Windowing
 
 	enum KeyCode
 	{
+		Unknown = -1,
+
 		Space      = 32,
 		Apostrophe = 39, /* ' */
 		Comma      = 44, /* , */
@@ -142,4 +144,19 @@ namespace SW::Windowing
 		Menu         = 348
 	};
 
+	// Number of the key codes, KeyCode::Menu is the last one
+	constexpr int KeyCount = KeyCode::Menu + 1;
+
+	// Whether the value is one of the KeyCode keys, the enum has gaps (e.g. 0-31 are no keys at all)
+	constexpr bool IsValidKeyCode(int key)
+	{
+		return key == KeyCode::Space || key == KeyCode::Apostrophe ||
+		       (key >= KeyCode::Comma && key <= KeyCode::D9) || key == KeyCode::Semicolon || key == KeyCode::Equal ||
+		       (key >= KeyCode::A && key <= KeyCode::RightBracket) || key == KeyCode::GraveAccent ||
+		       key == KeyCode::World1 || key == KeyCode::World2 || (key >= KeyCode::Escape && key <= KeyCode::End) ||
+		       (key >= KeyCode::CapsLock && key <= KeyCode::Pause) || (key >= KeyCode::F1 && key <= KeyCode::F25) ||
+		       (key >= KeyCode::KP0 && key <= KeyCode::KPEqual) ||
+		       (key >= KeyCode::LeftShift && key <= KeyCode::Menu);
+	}
+
 } // namespace SW::Windowing
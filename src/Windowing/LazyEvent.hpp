@@ -0,0 +1,77 @@
+/**
+ * @file LazyEvent.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <Eventing/Eventing.hpp>
+
+namespace SW::Windowing
+{
+	// Eventing::Event with the listener storage allocated only when the first listener is added.
+	// An event without listeners is a single null pointer and invoking it is a single branch.
+	// Forwards the whole Eventing::Event interface, the queries of an unallocated event report no listeners.
+	template <typename... Args>
+	class LazyEvent
+	{
+	public:
+		using EventType = Eventing::Event<Args...>;
+
+		template <typename Callback>
+		Eventing::ListenerID AddListener(Callback&& callback)
+		{
+			return GetOrAllocate().AddListener(std::forward<Callback>(callback));
+		}
+
+		// Returns false if the listener was not found (always for an unallocated event)
+		bool RemoveListener(Eventing::ListenerID listener)
+		{
+			return m_Event ? m_Event->RemoveListener(listener) : false;
+		}
+
+		void RemoveAllListeners()
+		{
+			if (m_Event)
+				m_Event->RemoveAllListeners();
+		}
+
+		auto GetListenerCount() const -> decltype(std::declval<const EventType&>().GetListenerCount())
+		{
+			return m_Event ? m_Event->GetListenerCount() : 0;
+		}
+
+		template <typename Callback>
+		Eventing::ListenerID operator+=(Callback&& callback)
+		{
+			return GetOrAllocate() += std::forward<Callback>(callback);
+		}
+
+		bool operator-=(Eventing::ListenerID listener) { return m_Event ? (*m_Event -= listener) : false; }
+
+		void Invoke(Args... args)
+		{
+			if (m_Event)
+				m_Event->Invoke(args...);
+		}
+
+		// Whether any listener was ever added (the storage is kept after the last one is removed)
+		bool IsAllocated() const { return m_Event != nullptr; }
+
+	private:
+		EventType& GetOrAllocate()
+		{
+			if (!m_Event)
+				m_Event = std::make_unique<EventType>();
+
+			return *m_Event;
+		}
+
+	private:
+		std::unique_ptr<EventType> m_Event;
+	};
+
+} // namespace SW::Windowing
@@ -0,0 +1,429 @@
+/**
+ * @file StaticEventDispatcher.hpp
+ *
+ * @copyright Copyright (c) 2024 Tycjan Fortuna
+ */
+#pragma once
+
+#include <tuple>
+
+#include <GLFW/glfw3.h>
+
+#include "Windowing/Window.hpp"
+
+namespace SW::Windowing
+{
+	// Sinks are plain objects exposing any subset of the following methods:
+	//  OnKeyPressed(KeyCode), OnKeyReleased(KeyCode), OnKeyRepeat(KeyCode),
+	//  OnMouseButtonPressed(MouseCode), OnMouseButtonReleased(MouseCode), OnMouseScrollWheel(float, float),
+	//  OnResize(int, int), OnFramebufferResize(int, int), OnMove(int, int), OnCursorMove(float, float),
+	//  OnMinimize(), OnMaximize(), OnGainFocus(), OnLostFocus(), OnClose()
+
+	template <typename Sink>
+	concept KeySink = requires(Sink& sink, KeyCode code) { sink.OnKeyPressed(code); } ||
+	                  requires(Sink& sink, KeyCode code) { sink.OnKeyReleased(code); } ||
+	                  requires(Sink& sink, KeyCode code) { sink.OnKeyRepeat(code); };
+
+	template <typename Sink>
+	concept MouseButtonSink = requires(Sink& sink, MouseCode code) { sink.OnMouseButtonPressed(code); } ||
+	                          requires(Sink& sink, MouseCode code) { sink.OnMouseButtonReleased(code); };
+
+	template <typename Sink>
+	concept ScrollSink = requires(Sink& sink, float offset) { sink.OnMouseScrollWheel(offset, offset); };
+
+	template <typename Sink>
+	concept ResizeSink = requires(Sink& sink, int size) { sink.OnResize(size, size); };
+
+	template <typename Sink>
+	concept FramebufferResizeSink = requires(Sink& sink, int size) { sink.OnFramebufferResize(size, size); };
+
+	template <typename Sink>
+	concept MoveSink = requires(Sink& sink, int position) { sink.OnMove(position, position); };
+
+	template <typename Sink>
+	concept CursorMoveSink = requires(Sink& sink, float position) { sink.OnCursorMove(position, position); };
+
+	template <typename Sink>
+	concept IconifySink = requires(Sink& sink) { sink.OnMinimize(); } || requires(Sink& sink) { sink.OnMaximize(); };
+
+	template <typename Sink>
+	concept FocusSink =
+	    requires(Sink& sink) { sink.OnGainFocus(); } || requires(Sink& sink) { sink.OnLostFocus(); };
+
+	template <typename Sink>
+	concept CloseSink = requires(Sink& sink) { sink.OnClose(); };
+
+	// Compile-time listener registration for the few hot, always-present listeners of a window (input manager,
+	// renderer, UI). Sinks are called directly (and can be inlined) before the window's dynamic Eventing::Event
+	// listeners, which stay available for everything else.
+	// Only one dispatcher can be attached to a window at a time, it must not outlive the window.
+	// Sinks receive their events even if the window has the event kinds disabled (see WindowEvents), the window's
+	// event mask must not change while the dispatcher is attached.
+	template <typename... Sinks>
+	class StaticEventDispatcher
+	{
+	public:
+		StaticEventDispatcher(Window* window, Sinks&... sinks) : m_Window(window), m_Sinks(sinks...)
+		{
+			GLFWwindow* handle = m_Window->GetWindowHandle();
+
+			ASSERT(glfwGetWindowUserPointer(handle) == nullptr, "Window already has a static event dispatcher!");
+
+			glfwSetWindowUserPointer(handle, this);
+
+			if constexpr ((KeySink<Sinks> || ...))
+				m_PreviousKeyCallback = glfwSetKeyCallback(handle, &StaticEventDispatcher::KeyCallback);
+
+			if constexpr ((MouseButtonSink<Sinks> || ...))
+				m_PreviousMouseButtonCallback =
+				    glfwSetMouseButtonCallback(handle, &StaticEventDispatcher::MouseButtonCallback);
+
+			if constexpr ((ScrollSink<Sinks> || ...))
+				m_PreviousScrollCallback = glfwSetScrollCallback(handle, &StaticEventDispatcher::ScrollCallback);
+
+			if constexpr ((ResizeSink<Sinks> || ...))
+				m_PreviousSizeCallback = glfwSetWindowSizeCallback(handle, &StaticEventDispatcher::SizeCallback);
+
+			if constexpr ((FramebufferResizeSink<Sinks> || ...))
+				m_PreviousFramebufferSizeCallback =
+				    glfwSetFramebufferSizeCallback(handle, &StaticEventDispatcher::FramebufferSizeCallback);
+
+			if constexpr ((MoveSink<Sinks> || ...))
+				m_PreviousPosCallback = glfwSetWindowPosCallback(handle, &StaticEventDispatcher::PosCallback);
+
+			if constexpr ((CursorMoveSink<Sinks> || ...))
+				m_PreviousCursorPosCallback =
+				    glfwSetCursorPosCallback(handle, &StaticEventDispatcher::CursorPosCallback);
+
+			if constexpr ((IconifySink<Sinks> || ...))
+				m_PreviousIconifyCallback =
+				    glfwSetWindowIconifyCallback(handle, &StaticEventDispatcher::IconifyCallback);
+
+			if constexpr ((FocusSink<Sinks> || ...))
+				m_PreviousFocusCallback = glfwSetWindowFocusCallback(handle, &StaticEventDispatcher::FocusCallback);
+
+			if constexpr ((CloseSink<Sinks> || ...))
+				m_PreviousCloseCallback = glfwSetWindowCloseCallback(handle, &StaticEventDispatcher::CloseCallback);
+		}
+
+		~StaticEventDispatcher()
+		{
+			GLFWwindow* handle = m_Window->GetWindowHandle();
+
+			// Give the window its own (dynamic only) callbacks back
+			if constexpr ((KeySink<Sinks> || ...))
+				glfwSetKeyCallback(handle, m_PreviousKeyCallback);
+
+			if constexpr ((MouseButtonSink<Sinks> || ...))
+				glfwSetMouseButtonCallback(handle, m_PreviousMouseButtonCallback);
+
+			if constexpr ((ScrollSink<Sinks> || ...))
+				glfwSetScrollCallback(handle, m_PreviousScrollCallback);
+
+			if constexpr ((ResizeSink<Sinks> || ...))
+				glfwSetWindowSizeCallback(handle, m_PreviousSizeCallback);
+
+			if constexpr ((FramebufferResizeSink<Sinks> || ...))
+				glfwSetFramebufferSizeCallback(handle, m_PreviousFramebufferSizeCallback);
+
+			if constexpr ((MoveSink<Sinks> || ...))
+				glfwSetWindowPosCallback(handle, m_PreviousPosCallback);
+
+			if constexpr ((CursorMoveSink<Sinks> || ...))
+				glfwSetCursorPosCallback(handle, m_PreviousCursorPosCallback);
+
+			if constexpr ((IconifySink<Sinks> || ...))
+				glfwSetWindowIconifyCallback(handle, m_PreviousIconifyCallback);
+
+			if constexpr ((FocusSink<Sinks> || ...))
+				glfwSetWindowFocusCallback(handle, m_PreviousFocusCallback);
+
+			if constexpr ((CloseSink<Sinks> || ...))
+				glfwSetWindowCloseCallback(handle, m_PreviousCloseCallback);
+
+			glfwSetWindowUserPointer(handle, nullptr);
+		}
+
+		StaticEventDispatcher(const StaticEventDispatcher&)            = delete;
+		StaticEventDispatcher& operator=(const StaticEventDispatcher&) = delete;
+
+		void DispatchKeyPressed(KeyCode code)
+		{
+			ForEachSink([code](auto& sink) {
+				if constexpr (requires { sink.OnKeyPressed(code); })
+					sink.OnKeyPressed(code);
+			});
+		}
+
+		void DispatchKeyReleased(KeyCode code)
+		{
+			ForEachSink([code](auto& sink) {
+				if constexpr (requires { sink.OnKeyReleased(code); })
+					sink.OnKeyReleased(code);
+			});
+		}
+
+		void DispatchKeyRepeat(KeyCode code)
+		{
+			ForEachSink([code](auto& sink) {
+				if constexpr (requires { sink.OnKeyRepeat(code); })
+					sink.OnKeyRepeat(code);
+			});
+		}
+
+		void DispatchMouseButtonPressed(MouseCode code)
+		{
+			ForEachSink([code](auto& sink) {
+				if constexpr (requires { sink.OnMouseButtonPressed(code); })
+					sink.OnMouseButtonPressed(code);
+			});
+		}
+
+		void DispatchMouseButtonReleased(MouseCode code)
+		{
+			ForEachSink([code](auto& sink) {
+				if constexpr (requires { sink.OnMouseButtonReleased(code); })
+					sink.OnMouseButtonReleased(code);
+			});
+		}
+
+		void DispatchMouseScrollWheel(float xOffset, float yOffset)
+		{
+			ForEachSink([xOffset, yOffset](auto& sink) {
+				if constexpr (requires { sink.OnMouseScrollWheel(xOffset, yOffset); })
+					sink.OnMouseScrollWheel(xOffset, yOffset);
+			});
+		}
+
+		void DispatchResize(int width, int height)
+		{
+			ForEachSink([width, height](auto& sink) {
+				if constexpr (requires { sink.OnResize(width, height); })
+					sink.OnResize(width, height);
+			});
+		}
+
+		void DispatchFramebufferResize(int width, int height)
+		{
+			ForEachSink([width, height](auto& sink) {
+				if constexpr (requires { sink.OnFramebufferResize(width, height); })
+					sink.OnFramebufferResize(width, height);
+			});
+		}
+
+		void DispatchMove(int x, int y)
+		{
+			ForEachSink([x, y](auto& sink) {
+				if constexpr (requires { sink.OnMove(x, y); })
+					sink.OnMove(x, y);
+			});
+		}
+
+		void DispatchCursorMove(float x, float y)
+		{
+			ForEachSink([x, y](auto& sink) {
+				if constexpr (requires { sink.OnCursorMove(x, y); })
+					sink.OnCursorMove(x, y);
+			});
+		}
+
+		void DispatchMinimize()
+		{
+			ForEachSink([](auto& sink) {
+				if constexpr (requires { sink.OnMinimize(); })
+					sink.OnMinimize();
+			});
+		}
+
+		void DispatchMaximize()
+		{
+			ForEachSink([](auto& sink) {
+				if constexpr (requires { sink.OnMaximize(); })
+					sink.OnMaximize();
+			});
+		}
+
+		void DispatchGainFocus()
+		{
+			ForEachSink([](auto& sink) {
+				if constexpr (requires { sink.OnGainFocus(); })
+					sink.OnGainFocus();
+			});
+		}
+
+		void DispatchLostFocus()
+		{
+			ForEachSink([](auto& sink) {
+				if constexpr (requires { sink.OnLostFocus(); })
+					sink.OnLostFocus();
+			});
+		}
+
+		void DispatchClose()
+		{
+			ForEachSink([](auto& sink) {
+				if constexpr (requires { sink.OnClose(); })
+					sink.OnClose();
+			});
+		}
+
+	private:
+		template <typename Func>
+		void ForEachSink(Func&& func)
+		{
+			std::apply([&func](auto&... sinks) { (func(sinks), ...); }, m_Sinks);
+		}
+
+		static StaticEventDispatcher* FindDispatcher(GLFWwindow* glfwWindow)
+		{
+			auto* dispatcher = static_cast<StaticEventDispatcher*>(glfwGetWindowUserPointer(glfwWindow));
+
+			ASSERT(dispatcher, "Static event dispatcher is null!");
+
+			return dispatcher;
+		}
+
+		// Sinks are called first, then the call is forwarded to the window's own callback (dynamic events)
+
+		static void KeyCallback(GLFWwindow* glfwWindow, int key, int scancode, int action, int mods)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			switch (action)
+			{
+			case GLFW_RELEASE:
+				dispatcher->DispatchKeyReleased((KeyCode)key);
+				break;
+			case GLFW_PRESS:
+				dispatcher->DispatchKeyPressed((KeyCode)key);
+				break;
+			case GLFW_REPEAT:
+				dispatcher->DispatchKeyRepeat((KeyCode)key);
+				break;
+			default:
+				break;
+			}
+
+			if (dispatcher->m_PreviousKeyCallback)
+				dispatcher->m_PreviousKeyCallback(glfwWindow, key, scancode, action, mods);
+		}
+
+		static void MouseButtonCallback(GLFWwindow* glfwWindow, int button, int action, int mods)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			if (action == GLFW_PRESS)
+				dispatcher->DispatchMouseButtonPressed((MouseCode)button);
+
+			if (action == GLFW_RELEASE)
+				dispatcher->DispatchMouseButtonReleased((MouseCode)button);
+
+			if (dispatcher->m_PreviousMouseButtonCallback)
+				dispatcher->m_PreviousMouseButtonCallback(glfwWindow, button, action, mods);
+		}
+
+		static void ScrollCallback(GLFWwindow* glfwWindow, double xOffset, double yOffset)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchMouseScrollWheel((float)xOffset, (float)yOffset);
+
+			if (dispatcher->m_PreviousScrollCallback)
+				dispatcher->m_PreviousScrollCallback(glfwWindow, xOffset, yOffset);
+		}
+
+		static void SizeCallback(GLFWwindow* glfwWindow, int width, int height)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchResize(width, height);
+
+			if (dispatcher->m_PreviousSizeCallback)
+				dispatcher->m_PreviousSizeCallback(glfwWindow, width, height);
+		}
+
+		static void FramebufferSizeCallback(GLFWwindow* glfwWindow, int width, int height)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchFramebufferResize(width, height);
+
+			if (dispatcher->m_PreviousFramebufferSizeCallback)
+				dispatcher->m_PreviousFramebufferSizeCallback(glfwWindow, width, height);
+		}
+
+		static void PosCallback(GLFWwindow* glfwWindow, int x, int y)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchMove(x, y);
+
+			if (dispatcher->m_PreviousPosCallback)
+				dispatcher->m_PreviousPosCallback(glfwWindow, x, y);
+		}
+
+		static void CursorPosCallback(GLFWwindow* glfwWindow, double x, double y)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchCursorMove((float)x, (float)y);
+
+			if (dispatcher->m_PreviousCursorPosCallback)
+				dispatcher->m_PreviousCursorPosCallback(glfwWindow, x, y);
+		}
+
+		static void IconifyCallback(GLFWwindow* glfwWindow, int iconified)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			if (iconified == GLFW_TRUE)
+				dispatcher->DispatchMinimize();
+
+			if (iconified == GLFW_FALSE)
+				dispatcher->DispatchMaximize();
+
+			if (dispatcher->m_PreviousIconifyCallback)
+				dispatcher->m_PreviousIconifyCallback(glfwWindow, iconified);
+		}
+
+		static void FocusCallback(GLFWwindow* glfwWindow, int focused)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			if (focused == GLFW_TRUE)
+				dispatcher->DispatchGainFocus();
+
+			if (focused == GLFW_FALSE)
+				dispatcher->DispatchLostFocus();
+
+			if (dispatcher->m_PreviousFocusCallback)
+				dispatcher->m_PreviousFocusCallback(glfwWindow, focused);
+		}
+
+		static void CloseCallback(GLFWwindow* glfwWindow)
+		{
+			StaticEventDispatcher* dispatcher = FindDispatcher(glfwWindow);
+
+			dispatcher->DispatchClose();
+
+			if (dispatcher->m_PreviousCloseCallback)
+				dispatcher->m_PreviousCloseCallback(glfwWindow);
+		}
+
+	private:
+		Window* m_Window = nullptr;
+
+		std::tuple<Sinks&...> m_Sinks;
+
+		GLFWkeyfun m_PreviousKeyCallback                         = nullptr;
+		GLFWmousebuttonfun m_PreviousMouseButtonCallback         = nullptr;
+		GLFWscrollfun m_PreviousScrollCallback                   = nullptr;
+		GLFWwindowsizefun m_PreviousSizeCallback                 = nullptr;
+		GLFWframebuffersizefun m_PreviousFramebufferSizeCallback = nullptr;
+		GLFWwindowposfun m_PreviousPosCallback                   = nullptr;
+		GLFWcursorposfun m_PreviousCursorPosCallback             = nullptr;
+		GLFWwindowiconifyfun m_PreviousIconifyCallback           = nullptr;
+		GLFWwindowfocusfun m_PreviousFocusCallback               = nullptr;
+		GLFWwindowclosefun m_PreviousCloseCallback               = nullptr;
+	};
+} // namespace SW::Windowing
@@ -1,5 +1,9 @@
 #include "Window.hpp"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
 #include <GLFW/glfw3.h>
 
 #ifdef WINDOWING_EXPOSE_NATIVE_WIN32
@@ -13,16 +17,87 @@
 namespace SW::Windowing
 {
 	std::unordered_map<GLFWwindow*, Window*> Window::s_WINDOWS;
+	std::vector<Window*> Window::s_BATCHED_WINDOWS;
+	std::vector<Window*> Window::s_FLUSHED_WINDOWS;
+	Window* Window::s_FLUSHING_WINDOW = nullptr;
+	std::unique_ptr<Window::EventBatch> Window::s_ORPHANED_BATCH;
+
+	// Hundreds of auxiliary windows are expected, events without listeners must stay a single pointer each
+	static_assert(sizeof(LazyEvent<int, int>) == sizeof(void*), "Unused window events must not allocate storage!");
+	// 640 bytes with libstdc++, the hot and warm cache lines plus the latch, throttle and titlebar state
+	static_assert(sizeof(Window) <= 640, "Window footprint grew, check the member layout!");
+
+	// Encodes the codepoint as UTF-8 into the output buffer, returns the number of written bytes (0 if invalid)
+	static int EncodeUTF8(unsigned int codepoint, char* out)
+	{
+		if (codepoint < 0x80)
+		{
+			out[0] = (char)codepoint;
+
+			return 1;
+		}
+
+		if (codepoint < 0x800)
+		{
+			out[0] = (char)(0xC0 | (codepoint >> 6));
+			out[1] = (char)(0x80 | (codepoint & 0x3F));
+
+			return 2;
+		}
+
+		if (codepoint < 0x10000)
+		{
+			if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+				return 0; // UTF-16 surrogates are not valid codepoints
+
+			out[0] = (char)(0xE0 | (codepoint >> 12));
+			out[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out[2] = (char)(0x80 | (codepoint & 0x3F));
+
+			return 3;
+		}
+
+		if (codepoint <= 0x10FFFF)
+		{
+			out[0] = (char)(0xF0 | (codepoint >> 18));
+			out[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+			out[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out[3] = (char)(0x80 | (codepoint & 0x3F));
+
+			return 4;
+		}
+
+		return 0;
+	}
 
-	Window::Window(const Device* device, const WindowSpecification& spec)
-	    : m_Device(device), m_Title(spec.Title), m_Size{spec.Width, spec.Height},
-	      m_MinimumSize{spec.MinimumWidth, spec.MinimumHeight}, m_MaximumSize{spec.MaximumWidth, spec.MaximumHeight},
-	      m_IsFullScreen(spec.IsFullScreen), m_CursorMode(spec.CursorMode), m_CursorShape(spec.CursorShape)
+	static void ApplyIcons(GLFWwindow* window, const WindowSpecification& spec)
+	{
+		std::shared_ptr<const IconSet> icons = nullptr;
+
+		if (!spec.Icons.empty())
+			icons = IconSet::Load(spec.Icons);
+		else if (spec.Icon.Data != nullptr)
+			icons = IconSet::Generate(spec.Icon);
+
+		if (icons)
+			icons->Apply(window);
+	}
+
+	Window::Window(Device* device, const WindowSpecification& spec)
+	    : m_Size{spec.Width, spec.Height},
+	      m_IsFullScreen(spec.IsFullScreen && spec.FullscreenMode == FullscreenMode::Exclusive), m_Device(device),
+	      m_Title(spec.Title), m_MinimumSize{spec.MinimumWidth, spec.MinimumHeight},
+	      m_MaximumSize{spec.MaximumWidth, spec.MaximumHeight}, m_WindowedSize{spec.Width, spec.Height},
+	      m_WasDecorated(spec.IsDecorated), m_IsTextInputOnDemand(spec.TextInputOnDemand),
+	      m_IsTextInputActive(!spec.TextInputOnDemand), m_RefreshRate(spec.RefreshRate),
+	      m_FullscreenMonitor(spec.FullscreenMonitor), m_DropChunkSize(spec.DropChunkSize),
+	      m_FullscreenMode(spec.FullscreenMode), m_EnabledEvents(spec.Events), m_CursorMode(spec.CursorMode),
+	      m_CursorShape(spec.CursorShape), m_IsLateLatchEnabled(spec.LateLatchInput), m_ThrottlePolicy(spec.Throttle)
 	{
 		GLFWmonitor* selectedMonitor = nullptr;
 
 		if (m_IsFullScreen)
-			selectedMonitor = glfwGetPrimaryMonitor();
+			selectedMonitor = GetSelectedMonitor().Handle;
 
 		glfwWindowHint(GLFW_RESIZABLE, spec.IsResizeable);
 		glfwWindowHint(GLFW_DECORATED, spec.IsDecorated);
@@ -34,85 +109,41 @@ namespace SW::Windowing
 		glfwWindowHint(GLFW_AUTO_ICONIFY, spec.AutoIconify);
 		glfwWindowHint(GLFW_REFRESH_RATE, spec.RefreshRate);
 
-		m_Handle = glfwCreateWindow(spec.Width, spec.Height, spec.Title.c_str(), selectedMonitor, nullptr);
+		GLFWwindow* sharedContext = spec.SharedContext ? spec.SharedContext->GetWindowHandle() : nullptr;
+
+		m_Handle = glfwCreateWindow(spec.Width, spec.Height, spec.Title.c_str(), selectedMonitor, sharedContext);
 
 		VERIFY(m_Handle, "Failed to create GLFW window");
 
 		UpdateSizeLimit();
 		SetCursorMode(spec.CursorMode);
-		SetCursorShape(spec.CursorShape);
-
-		if (spec.Icon.Data != nullptr)
-		{
-			GLFWimage icon;
-			int channels;
-
-			icon.pixels =
-			    stbi_load_from_memory(spec.Icon.Data, spec.Icon.Size, &icon.width, &icon.height, &channels, 4);
+		glfwSetCursor(m_Handle, m_Device->GetCursorInstance(spec.CursorShape));
 
-			glfwSetWindowIcon(m_Handle, 1, &icon);
-
-			stbi_image_free(icon.pixels);
-		}
+		ApplyIcons(m_Handle, spec);
 
 		glfwGetWindowPos(m_Handle, &m_Position.first, &m_Position.second);
 
-		s_WINDOWS[m_Handle] = this;
-
-		glfwSetKeyCallback(m_Handle, [](GLFWwindow* glfwWindow, int key, int /*scancode*/, int action, int
-		                                /*mods*/) {
-			Window* window  = FindInstance(glfwWindow);
-			KeyCode keyCode = (KeyCode)key;
-
-			ASSERT(window, "Window handle is null!");
-
-			switch (action)
-			{
-			case GLFW_RELEASE: {
-				window->KeyReleasedEvent.Invoke(keyCode);
-				break;
-			}
-			case GLFW_PRESS: {
-				window->KeyPressedEvent.Invoke(keyCode);
-				break;
-			}
-			case GLFW_REPEAT: {
-				window->KeyRepeatEvent.Invoke(keyCode);
-				break;
-			}
-			default:
-				ASSERT(false, "Unsupported key event action: {}");
-			}
-		});
-
-		glfwSetMouseButtonCallback(m_Handle, [](GLFWwindow* glfwWindow, int button, int action, int /*mods*/) {
-			Window* window      = FindInstance(glfwWindow);
-			MouseCode mouseCode = (MouseCode)button;
+		if (spec.IsFullScreen && m_FullscreenMode == FullscreenMode::Borderless)
+			SetBorderlessFullscreen(GetSelectedMonitor());
 
-			ASSERT(window, "Window handle is null!");
+		m_TextInput.reserve(spec.TextInputCapacity);
 
-			switch (action)
-			{
-			case GLFW_RELEASE: {
-				window->MouseButtonReleasedEvent.Invoke(mouseCode);
+		s_WINDOWS[m_Handle] = this;
 
-				break;
-			}
-			case GLFW_PRESS: {
-				window->MouseButtonPressedEvent.Invoke(mouseCode);
+		m_IsIconified = glfwGetWindowAttrib(m_Handle, GLFW_ICONIFIED) == GLFW_TRUE;
+		m_IsFocused   = glfwGetWindowAttrib(m_Handle, GLFW_FOCUSED) == GLFW_TRUE;
 
-				break;
-			}
-			default:
-				ASSERT(false, "Unsupported mouse event action: {}");
-			}
-		});
+		SetCharCallbackEnabled(m_IsTextInputActive);
+		SetEventCallbacks(m_EnabledEvents, true);
 
 		glfwSetWindowIconifyCallback(m_Handle, [](GLFWwindow* glfwWindow, int iconified) {
 			Window* window = FindInstance(glfwWindow);
 
 			ASSERT(window, "Window handle is null!");
 
+			window->m_IsIconified = iconified == GLFW_TRUE;
+			window->RecordEvent(iconified == GLFW_TRUE ? EventRecordType::Minimize : EventRecordType::Restore);
+
 			if (iconified == GLFW_TRUE)
 				window->MinimizeEvent.Invoke();
 
@@ -126,6 +157,7 @@ namespace SW::Windowing
 			ASSERT(window, "Window handle is null!");
 
 			window->CloseEvent.Invoke();
+			window->RecordEvent(EventRecordType::Close);
 		});
 
 		glfwSetWindowSizeCallback(m_Handle, [](GLFWwindow* glfwWindow, int width, int height) {
@@ -136,7 +168,10 @@ namespace SW::Windowing
 			if (glfwWindow != glfwGetCurrentContext())
 				window->MakeContextCurrent();
 
+			window->OnResize(width, height);
 			window->ResizeEvent.Invoke(width, height);
+			window->RecordEvent(EventRecordType::Resize, 0, (float)width, (float)height);
+			window->m_Device->GetScheduler().Signal(window, WaitEvent::Resized, 0);
 
 			// TODO: Move this to event listener
 #ifdef WINDOWING_OPENGL_CONTEXT
@@ -144,28 +179,14 @@ namespace SW::Windowing
 #endif
 		});
 
-		glfwSetFramebufferSizeCallback(m_Handle, [](GLFWwindow* glfwWindow, int width, int height) {
-			Window* window = FindInstance(glfwWindow);
-
-			ASSERT(window, "Window handle is null!");
-
-			window->FramebufferResizeEvent.Invoke(width, height);
-		});
-
-		glfwSetCursorPosCallback(m_Handle, [](GLFWwindow* glfwWindow, double x, double y) {
-			Window* window = FindInstance(glfwWindow);
-
-			ASSERT(window, "Window handle is null!");
-
-			window->CursorMoveEvent.Invoke((float)x, (float)y);
-		});
-
 		glfwSetWindowPosCallback(m_Handle, [](GLFWwindow* glfwWindow, int x, int y) {
 			Window* window = FindInstance(glfwWindow);
 
 			ASSERT(window, "Window handle is null!");
 
+			window->OnMove(x, y);
 			window->MoveEvent.Invoke(x, y);
+			window->RecordEvent(EventRecordType::Move, 0, (float)x, (float)y);
 		});
 
 		glfwSetWindowFocusCallback(m_Handle, [](GLFWwindow* glfwWindow, int focused) {
@@ -173,39 +194,61 @@ namespace SW::Windowing
 
 			ASSERT(window, "Window handle is null!");
 
+			window->m_IsFocused = focused == GLFW_TRUE;
+			window->RecordEvent(focused == GLFW_TRUE ? EventRecordType::GainFocus : EventRecordType::LostFocus);
+
 			if (focused == GLFW_TRUE)
+			{
+				// The keyboard layout is usually switched while the application is in the background
+				window->m_Device->RefreshKeyboardLayout();
+
 				window->GainFocusEvent.Invoke();
+			}
 
 			if (focused == GLFW_FALSE)
 				window->LostFocusEvent.Invoke();
 		});
 
-		glfwSetTitlebarHitTestCallback(m_Handle, [](GLFWwindow* glfwWindow, int /*xPos*/, int /*yPos*/, int* hit) {
+		glfwSetTitlebarHitTestCallback(m_Handle, [](GLFWwindow* glfwWindow, int xPos, int yPos, int* hit) {
 			Window* window = FindInstance(glfwWindow);
 
 			ASSERT(window, "Window handle is null!");
 
-			*hit = window->IsOverTitleBar() ? 1 : 0;
-		});
-
-		glfwSetScrollCallback(m_Handle, [](GLFWwindow* glfwWindow, double xOffset, double yOffset) {
-			Window* window = FindInstance(glfwWindow);
-
-			window->MouseScrollWheelEvent.Invoke(xOffset, yOffset);
+			if (window->m_TitlebarRegions.empty())
+				*hit = window->IsOverTitleBar() ? 1 : 0;
+			else
+				*hit = window->HitTestTitlebar(xPos, yPos) == TitlebarHit::Drag ? 1 : 0;
 		});
-
-		ResizeEvent += std::bind_front(&Window::OnResize, this);
-		MoveEvent += std::bind_front(&Window::OnMove, this);
 	}
 
 	Window::~Window()
 	{
+		s_WINDOWS.erase(m_Handle);
+
+		// Possibly destroyed by a batch listener during the flush
+		std::replace(s_BATCHED_WINDOWS.begin(), s_BATCHED_WINDOWS.end(), this, (Window*)nullptr);
+		std::replace(s_FLUSHED_WINDOWS.begin(), s_FLUSHED_WINDOWS.end(), this, (Window*)nullptr);
+
+		// Its batch listeners are still being invoked, the batch is destroyed once they return
+		if (s_FLUSHING_WINDOW == this)
+		{
+			s_ORPHANED_BATCH  = std::move(m_EventBatch);
+			s_FLUSHING_WINDOW = nullptr;
+		}
+
+		m_Device->GetScheduler().ForgetWindow(this);
+
+		if (m_Device->IsAnimatedCursor(m_Cursor))
+			m_Device->DetachAnimatedCursor(m_Handle);
+
 		glfwDestroyWindow(m_Handle);
 	}
 
 	Window* Window::FindInstance(GLFWwindow* glfwWindow)
 	{
-		return s_WINDOWS.find(glfwWindow) != s_WINDOWS.end() ? s_WINDOWS[glfwWindow] : nullptr;
+		auto it = s_WINDOWS.find(glfwWindow);
+
+		return it != s_WINDOWS.end() ? it->second : nullptr;
 	}
 
 	void Window::SetSize(int width, int height)
@@ -236,7 +279,7 @@ namespace SW::Windowing
 
 	bool Window::IsMinimized() const
 	{
-		return glfwGetWindowAttrib(m_Handle, GLFW_MAXIMIZED) == GLFW_FALSE;
+		return m_IsIconified;
 	}
 
 	void Window::Minimize() const
@@ -289,6 +332,65 @@ namespace SW::Windowing
 		glfwFocusWindow(m_Handle);
 	}
 
+	ActivityState Window::GetActivityState() const
+	{
+		if (m_IsIconified)
+			return ActivityState::Iconified;
+
+		if (IsHidden())
+			return ActivityState::Hidden;
+
+		return m_IsFocused ? ActivityState::Focused : ActivityState::Unfocused;
+	}
+
+	float Window::GetThrottledFrameRate() const
+	{
+		switch (GetActivityState())
+		{
+		case ActivityState::Focused:
+			return m_ThrottlePolicy.FocusedFrameRate;
+		case ActivityState::Unfocused:
+			return m_ThrottlePolicy.UnfocusedFrameRate;
+		case ActivityState::Hidden:
+			return m_ThrottlePolicy.HiddenFrameRate;
+		case ActivityState::Iconified:
+			return m_ThrottlePolicy.IconifiedFrameRate;
+		}
+
+		return ThrottlePolicy::Unlimited;
+	}
+
+	bool Window::Throttle()
+	{
+		// Every wait processes the events, so the state is re-evaluated after each wake up
+		while (!ShouldClose())
+		{
+			const float frameRate = GetThrottledFrameRate();
+
+			if (frameRate == ThrottlePolicy::Unlimited)
+				break;
+
+			if (frameRate < 0.0f)
+			{
+				m_Device->WaitEvents();
+
+				continue;
+			}
+
+			const double time          = glfwGetTime();
+			const double nextFrameTime = m_LastThrottledFrameTime + 1.0 / frameRate;
+
+			if (time >= nextFrameTime)
+				break;
+
+			m_Device->WaitEvents(nextFrameTime - time);
+		}
+
+		m_LastThrottledFrameTime = glfwGetTime();
+
+		return !ShouldClose();
+	}
+
 	bool Window::IsFullscreen() const
 	{
 		return m_IsFullScreen;
@@ -297,13 +399,88 @@ namespace SW::Windowing
 	void Window::SetFullscreen(bool value)
 	{
 		if (value)
-			m_IsFullScreen = true;
+		{
+			if (m_FullscreenMode == FullscreenMode::Borderless)
+			{
+				SetBorderlessFullscreen(GetSelectedMonitor());
+
+				return;
+			}
+
+			SetFullscreen(GetSelectedMonitor(), VideoMode{
+			                                         .Width       = m_Size.first,
+			                                         .Height      = m_Size.second,
+			                                         .RefreshRate = m_RefreshRate,
+			                                     });
+
+			return;
+		}
+
+		if (!m_IsFullScreen)
+			return;
+
+		if (m_IsBorderlessFullScreen)
+			glfwSetWindowAttrib(m_Handle, GLFW_DECORATED, m_WasDecorated);
+
+		glfwSetWindowMonitor(m_Handle, nullptr, m_Position.first, m_Position.second, m_WindowedSize.first,
+		                     m_WindowedSize.second, m_RefreshRate);
+
+		m_IsFullScreen = false;
+
+		// Leaving the exclusive full screen restores the monitor's video mode
+		if (!m_IsBorderlessFullScreen)
+			m_Device->RefreshMonitors();
+
+		m_IsBorderlessFullScreen = false;
+	}
+
+	void Window::SetFullscreen(const MonitorInfo& monitor, const VideoMode& mode)
+	{
+		if (!m_IsFullScreen)
+			m_WindowedSize = m_Size;
+
+		if (m_IsBorderlessFullScreen)
+			glfwSetWindowAttrib(m_Handle, GLFW_DECORATED, m_WasDecorated);
+
+		m_IsFullScreen           = true;
+		m_IsBorderlessFullScreen = false;
+
+		glfwSetWindowMonitor(m_Handle, monitor.Handle, 0, 0, mode.Width, mode.Height,
+		                     mode.RefreshRate > 0 ? mode.RefreshRate : GLFW_DONT_CARE);
+
+		m_Device->RefreshMonitors();
+	}
+
+	void Window::SetBorderlessFullscreen(const MonitorInfo& monitor)
+	{
+		const bool wasWindowed = !m_IsFullScreen;
+
+		// Leave the exclusive mode first, so the monitor gets its video mode back
+		if (m_IsFullScreen && !m_IsBorderlessFullScreen)
+			SetFullscreen(false);
+
+		if (wasWindowed)
+			m_WindowedSize = m_Size;
+
+		if (!m_IsBorderlessFullScreen)
+			m_WasDecorated = IsDecorated();
+
+		// Set before moving, so the windowed position is not overwritten
+		m_IsFullScreen           = true;
+		m_IsBorderlessFullScreen = true;
 
-		glfwSetWindowMonitor(m_Handle, value ? glfwGetPrimaryMonitor() : nullptr, m_Position.first, m_Position.second,
-		                     m_Size.first, m_Size.second, m_RefreshRate);
+		// Queried again, the task bars may have moved since the monitor info was taken
+		MonitorWorkArea area = monitor.WorkArea;
 
-		if (!value)
-			m_IsFullScreen = false;
+		if (monitor.Handle)
+			glfwGetMonitorWorkarea(monitor.Handle, &area.X, &area.Y, &area.Width, &area.Height);
+
+		glfwSetWindowAttrib(m_Handle, GLFW_DECORATED, GLFW_FALSE);
+		glfwSetWindowMonitor(m_Handle, nullptr, area.X, area.Y, area.Width, area.Height, GLFW_DONT_CARE);
+
+		// The callbacks are not installed yet when called by the constructor, so the resize may never be delivered.
+		// m_Position keeps the windowed position while in full screen (see OnMove).
+		m_Size = {area.Width, area.Height};
 	}
 
 	void Window::ToggleFullscreen()
@@ -311,6 +488,15 @@ namespace SW::Windowing
 		SetFullscreen(!m_IsFullScreen);
 	}
 
+	void Window::ToggleFullscreen(FullscreenMode mode)
+	{
+		const FullscreenMode previous = m_FullscreenMode;
+
+		m_FullscreenMode = mode;
+		SetFullscreen(!m_IsFullScreen);
+		m_FullscreenMode = previous;
+	}
+
 	bool Window::IsResizable() const
 	{
 		return glfwGetWindowAttrib(m_Handle, GLFW_RESIZABLE) == GLFW_TRUE;
@@ -331,9 +517,124 @@ namespace SW::Windowing
 		glfwMakeContextCurrent(m_Handle);
 	}
 
-	void Window::SwapBuffers() const
+	void Window::SwapBuffers()
 	{
+		if (m_IsLateLatchEnabled)
+			LatchInput();
+
+		const double startTime = glfwGetTime();
+
 		glfwSwapBuffers(m_Handle);
+
+		RecordPresent(startTime, glfwGetTime());
+	}
+
+	void Window::LatchInput()
+	{
+		// GLFW caches the button state (and on Wayland the cursor position too) until the events are processed, so
+		// the queue is drained first. The drained events go through the regular callbacks and are published with the
+		// next frame's snapshot, ClearReleasedKeys and ClearTextInput already ran for this frame.
+		glfwPollEvents();
+
+		double x, y;
+		glfwGetCursorPos(m_Handle, &x, &y);
+
+		unsigned int buttons = 0;
+
+		for (int button = 0; button <= MouseCode::ButtonLast; button++)
+		{
+			if (glfwGetMouseButton(m_Handle, button) == GLFW_PRESS)
+				buttons |= 1u << button;
+		}
+
+		const unsigned long long sequence = m_LatchSequence.load(std::memory_order_relaxed);
+
+		m_LatchSequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		m_LatchTime.store(glfwGetTime(), std::memory_order_relaxed);
+		m_LatchMouseX.store((float)x, std::memory_order_relaxed);
+		m_LatchMouseY.store((float)y, std::memory_order_relaxed);
+		m_LatchMouseButtons.store(buttons, std::memory_order_relaxed);
+
+		m_LatchSequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	LatchedInput Window::GetLatchedInput() const
+	{
+		LatchedInput input;
+
+		unsigned long long sequence;
+
+		do
+		{
+			sequence = m_LatchSequence.load(std::memory_order_acquire);
+
+			// Writes never block, so the retry is short
+			if (sequence & 1)
+				continue;
+
+			input.Time          = m_LatchTime.load(std::memory_order_relaxed);
+			input.MousePosition = {m_LatchMouseX.load(std::memory_order_relaxed),
+			                       m_LatchMouseY.load(std::memory_order_relaxed)};
+			input.MouseButtons  = m_LatchMouseButtons.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while ((sequence & 1) || m_LatchSequence.load(std::memory_order_relaxed) != sequence);
+
+		input.Sequence = sequence / 2;
+
+		return input;
+	}
+
+	void Window::SetSwapInterval(int interval)
+	{
+		// Vulkan windows have no context to make current, their swap interval is the present mode of the swapchain
+		if (!m_Device->HasContext())
+			return;
+
+		GLFWwindow* previousContext = glfwGetCurrentContext();
+
+		// The swap interval applies to the current context only
+		if (previousContext != m_Handle)
+			glfwMakeContextCurrent(m_Handle);
+
+		if (interval < 0 && !glfwExtensionSupported("WGL_EXT_swap_control_tear") &&
+		    !glfwExtensionSupported("GLX_EXT_swap_control_tear"))
+		{
+			interval = -interval;
+		}
+
+		glfwSwapInterval(interval);
+
+		if (previousContext != m_Handle)
+			glfwMakeContextCurrent(previousContext);
+
+		m_SwapInterval = interval;
+	}
+
+	VSyncMode Window::GetVSync() const
+	{
+		if (m_SwapInterval < 0)
+			return VSyncMode::Adaptive;
+
+		return m_SwapInterval == 0 ? VSyncMode::Off : VSyncMode::On;
+	}
+
+	void Window::SetVSync(VSyncMode mode)
+	{
+		switch (mode)
+		{
+		case VSyncMode::Off:
+			SetSwapInterval(0);
+			break;
+		case VSyncMode::On:
+			SetSwapInterval(1);
+			break;
+		case VSyncMode::Adaptive:
+			SetSwapInterval(-1);
+			break;
+		}
 	}
 
 	void Window::SetCursorMode(CursorMode cursorMode)
@@ -344,19 +645,84 @@ namespace SW::Windowing
 
 	void Window::SetCursorShape(CursorShape cursorShape)
 	{
+		if (m_CursorShape == cursorShape && m_Cursor == InvalidCursor)
+			return;
+
+		if (m_Device->IsAnimatedCursor(m_Cursor))
+			m_Device->DetachAnimatedCursor(m_Handle);
+
 		m_CursorShape = cursorShape;
+		m_Cursor      = InvalidCursor;
+
 		glfwSetCursor(m_Handle, m_Device->GetCursorInstance(cursorShape));
 	}
 
+	void Window::SetCursor(CursorID cursor)
+	{
+		if (m_Cursor == cursor)
+			return;
+
+		if (cursor == InvalidCursor)
+		{
+			// Back to the standard shape
+			m_Cursor = InvalidCursor;
+
+			m_Device->DetachAnimatedCursor(m_Handle);
+			glfwSetCursor(m_Handle, m_Device->GetCursorInstance(m_CursorShape));
+
+			return;
+		}
+
+		m_Cursor = cursor;
+
+		glfwSetCursor(m_Handle, m_Device->GetCursorInstance(cursor));
+
+		if (m_Device->IsAnimatedCursor(cursor))
+			m_Device->AttachAnimatedCursor(m_Handle, cursor);
+		else
+			m_Device->DetachAnimatedCursor(m_Handle);
+	}
+
+	void Window::AppendTextInput(std::string_view text)
+	{
+		m_TextInput.append(text);
+	}
+
+	void Window::ClearTextInput()
+	{
+		m_TextInput.clear();
+	}
+
+	void Window::BeginTextInput()
+	{
+		if (!m_IsTextInputOnDemand || m_IsTextInputActive)
+			return;
+
+		m_IsTextInputActive = true;
+		SetCharCallbackEnabled(true);
+	}
+
+	void Window::EndTextInput()
+	{
+		if (!m_IsTextInputOnDemand || !m_IsTextInputActive)
+			return;
+
+		m_IsTextInputActive = false;
+		SetCharCallbackEnabled(false);
+	}
+
 	void Window::SetCursorPosition(int x, int y)
 	{
 		glfwSetCursorPos(m_Handle, (double)x, (double)y);
 	}
 
-	void Window::SetTitle(const std::string& title)
+	void Window::SetTitle(std::string_view title)
 	{
-		m_Title = title;
-		glfwSetWindowTitle(m_Handle, title.c_str());
+		if (m_Title == title)
+			return;
+
+		m_Title.assign(title);
+		glfwSetWindowTitle(m_Handle, m_Title.c_str());
 	}
 
 	std::pair<int, int> Window::GetFramebufferSize() const
@@ -382,12 +748,366 @@ namespace SW::Windowing
 		}
 	}
 
+	const MonitorInfo& Window::GetSelectedMonitor() const
+	{
+		const std::vector<MonitorInfo>& monitors = m_Device->GetMonitors();
+
+		if (m_FullscreenMonitor >= 0 && m_FullscreenMonitor < (int)monitors.size())
+			return monitors[m_FullscreenMonitor];
+
+		return m_Device->GetPrimaryMonitor();
+	}
+
+	// Exponential moving average, the first sample initializes it
+	static double UpdateAverage(double average, double sample, bool isFirstSample)
+	{
+		// Weight of the newest sample
+		constexpr double smoothing = 0.1;
+
+		return isFirstSample ? sample : average + (sample - average) * smoothing;
+	}
+
+	void Window::RecordPresent(double startTime, double endTime)
+	{
+		PresentStatistics& stats = m_PresentStatistics;
+
+		stats.LastBlockingTime    = endTime - startTime;
+		stats.AverageBlockingTime = UpdateAverage(stats.AverageBlockingTime, stats.LastBlockingTime,
+		                                          stats.PresentCount == 0);
+
+		const int centerX = m_Position.first + m_Size.first / 2;
+		const int centerY = m_Position.second + m_Size.second / 2;
+
+		const MonitorInfo* monitor = m_Device->FindMonitorAt(centerX, centerY);
+
+		stats.RefreshPeriod = monitor && monitor->CurrentMode.RefreshRate > 0
+		                          ? 1.0 / (double)monitor->CurrentMode.RefreshRate
+		                          : 0.0;
+
+		if (stats.PresentCount > 0)
+		{
+			stats.LastPresentInterval    = endTime - m_LastPresentTime;
+			stats.AveragePresentInterval = UpdateAverage(stats.AveragePresentInterval, stats.LastPresentInterval,
+			                                             stats.PresentCount == 1);
+
+			const int vblanks = m_SwapInterval < 0 ? -m_SwapInterval : m_SwapInterval;
+
+			// Half a period of tolerance for the timer and scheduler jitter
+			if (vblanks > 0 && stats.RefreshPeriod > 0.0 &&
+			    stats.LastPresentInterval > (vblanks + 0.5) * stats.RefreshPeriod)
+			{
+				stats.MissedVBlankCount++;
+			}
+		}
+
+		stats.PresentCount++;
+
+		m_LastPresentTime = endTime;
+	}
+
+	void Window::OnDrop(int count, const char* paths[])
+	{
+		m_DropPaths.clear();
+		m_DropPaths.reserve(count);
+
+		size_t totalLength = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			const std::string_view path = m_DropPaths.emplace_back(paths[i], std::strlen(paths[i]));
+
+			totalLength += path.size();
+		}
+
+		// Reserved up front, so the arena never reallocates and the already delivered views stay valid
+		m_DropArena.clear();
+		m_DropArena.reserve(totalLength);
+
+		size_t chunkBegin = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			const size_t offset = m_DropArena.size();
+
+			m_DropArena.append(m_DropPaths[i]);
+			m_DropPaths[i] = std::string_view(m_DropArena.data() + offset, m_DropPaths[i].size());
+
+			const size_t copied = (size_t)i + 1;
+
+			if (m_DropChunkSize > 0 && (copied - chunkBegin == (size_t)m_DropChunkSize || copied == (size_t)count))
+			{
+				const std::span<const std::string_view> dropped(m_DropPaths);
+
+				DropChunkEvent.Invoke(dropped.subspan(chunkBegin, copied - chunkBegin));
+
+				chunkBegin = copied;
+			}
+		}
+
+		DropEvent.Invoke(std::span<const std::string_view>(m_DropPaths));
+	}
+
 	void Window::UpdateSizeLimit() const
 	{
 		glfwSetWindowSizeLimits(m_Handle, m_MinimumSize.first, m_MinimumSize.second, m_MaximumSize.first,
 		                        m_MaximumSize.second);
 	}
 
+	void Window::EnableEvents(WindowEvents events)
+	{
+		ASSERT(glfwGetWindowUserPointer(m_Handle) == nullptr, "Detach the static event dispatcher first!");
+
+		events = events & ~m_EnabledEvents;
+
+		SetEventCallbacks(events, true);
+
+		m_EnabledEvents = m_EnabledEvents | events;
+	}
+
+	void Window::DisableEvents(WindowEvents events)
+	{
+		ASSERT(glfwGetWindowUserPointer(m_Handle) == nullptr, "Detach the static event dispatcher first!");
+
+		events = events & m_EnabledEvents;
+
+		SetEventCallbacks(events, false);
+
+		m_EnabledEvents = m_EnabledEvents & ~events;
+	}
+
+	void Window::SetEventCallbacks(WindowEvents events, bool enabled)
+	{
+		if (!enabled)
+		{
+			if (HasEvents(events, WindowEvents::Key))
+				glfwSetKeyCallback(m_Handle, nullptr);
+
+			if (HasEvents(events, WindowEvents::MouseButton))
+				glfwSetMouseButtonCallback(m_Handle, nullptr);
+
+			if (HasEvents(events, WindowEvents::Scroll))
+				glfwSetScrollCallback(m_Handle, nullptr);
+
+			if (HasEvents(events, WindowEvents::CursorMove))
+				glfwSetCursorPosCallback(m_Handle, nullptr);
+
+			if (HasEvents(events, WindowEvents::FramebufferResize))
+				glfwSetFramebufferSizeCallback(m_Handle, nullptr);
+
+			if (HasEvents(events, WindowEvents::Drop))
+				glfwSetDropCallback(m_Handle, nullptr);
+
+			return;
+		}
+
+		if (HasEvents(events, WindowEvents::Key))
+		{
+			glfwSetKeyCallback(m_Handle, [](GLFWwindow* glfwWindow, int key, int /*scancode*/, int action, int
+			                                /*mods*/) {
+				Window* window  = FindInstance(glfwWindow);
+				KeyCode keyCode = (KeyCode)key;
+
+				ASSERT(window, "Window handle is null!");
+
+				switch (action)
+				{
+				case GLFW_RELEASE: {
+					window->KeyReleasedEvent.Invoke(keyCode);
+					window->RecordEvent(EventRecordType::KeyReleased, key);
+					break;
+				}
+				case GLFW_PRESS: {
+					window->KeyPressedEvent.Invoke(keyCode);
+					window->RecordEvent(EventRecordType::KeyPressed, key);
+					window->m_Device->GetScheduler().Signal(window, WaitEvent::KeyPressed, key);
+					break;
+				}
+				case GLFW_REPEAT: {
+					window->KeyRepeatEvent.Invoke(keyCode);
+					window->RecordEvent(EventRecordType::KeyRepeat, key);
+					break;
+				}
+				default:
+					ASSERT(false, "Unsupported key event action: {}");
+				}
+			});
+		}
+
+		if (HasEvents(events, WindowEvents::MouseButton))
+		{
+			glfwSetMouseButtonCallback(m_Handle, [](GLFWwindow* glfwWindow, int button, int action, int /*mods*/) {
+				Window* window      = FindInstance(glfwWindow);
+				MouseCode mouseCode = (MouseCode)button;
+
+				ASSERT(window, "Window handle is null!");
+
+				switch (action)
+				{
+				case GLFW_RELEASE: {
+					window->MouseButtonReleasedEvent.Invoke(mouseCode);
+					window->RecordEvent(EventRecordType::MouseButtonReleased, button);
+
+					break;
+				}
+				case GLFW_PRESS: {
+					window->MouseButtonPressedEvent.Invoke(mouseCode);
+					window->RecordEvent(EventRecordType::MouseButtonPressed, button);
+
+					break;
+				}
+				default:
+					ASSERT(false, "Unsupported mouse event action: {}");
+				}
+			});
+		}
+
+		if (HasEvents(events, WindowEvents::Scroll))
+		{
+			glfwSetScrollCallback(m_Handle, [](GLFWwindow* glfwWindow, double xOffset, double yOffset) {
+				Window* window = FindInstance(glfwWindow);
+
+				ASSERT(window, "Window handle is null!");
+
+				window->MouseScrollWheelEvent.Invoke(xOffset, yOffset);
+				window->RecordEvent(EventRecordType::MouseScroll, 0, (float)xOffset, (float)yOffset);
+			});
+		}
+
+		if (HasEvents(events, WindowEvents::CursorMove))
+		{
+			glfwSetCursorPosCallback(m_Handle, [](GLFWwindow* glfwWindow, double x, double y) {
+				Window* window = FindInstance(glfwWindow);
+
+				ASSERT(window, "Window handle is null!");
+
+				window->CursorMoveEvent.Invoke((float)x, (float)y);
+				window->RecordEvent(EventRecordType::CursorMove, 0, (float)x, (float)y);
+			});
+		}
+
+		if (HasEvents(events, WindowEvents::FramebufferResize))
+		{
+			glfwSetFramebufferSizeCallback(m_Handle, [](GLFWwindow* glfwWindow, int width, int height) {
+				Window* window = FindInstance(glfwWindow);
+
+				ASSERT(window, "Window handle is null!");
+
+				window->FramebufferResizeEvent.Invoke(width, height);
+				window->RecordEvent(EventRecordType::FramebufferResize, 0, (float)width, (float)height);
+			});
+		}
+
+		if (HasEvents(events, WindowEvents::Drop))
+		{
+			glfwSetDropCallback(m_Handle, [](GLFWwindow* glfwWindow, int count, const char* paths[]) {
+				Window* window = FindInstance(glfwWindow);
+
+				ASSERT(window, "Window handle is null!");
+
+				window->OnDrop(count, paths);
+			});
+		}
+	}
+
+	void Window::Reuse(const WindowSpecification& spec)
+	{
+		ASSERT(!spec.IsFullScreen, "Pooled windows can not be created full screen!");
+
+		SetTitle(spec.Title);
+
+		glfwSetWindowAttrib(m_Handle, GLFW_RESIZABLE, spec.IsResizeable);
+		glfwSetWindowAttrib(m_Handle, GLFW_DECORATED, spec.IsDecorated);
+		glfwSetWindowAttrib(m_Handle, GLFW_FLOATING, spec.IsFloating);
+		glfwSetWindowAttrib(m_Handle, GLFW_AUTO_ICONIFY, spec.AutoIconify);
+
+		m_MinimumSize  = {spec.MinimumWidth, spec.MinimumHeight};
+		m_MaximumSize  = {spec.MaximumWidth, spec.MaximumHeight};
+		m_WindowedSize = {spec.Width, spec.Height};
+
+		UpdateSizeLimit();
+
+		if (m_Size != m_WindowedSize)
+			SetSize(spec.Width, spec.Height);
+
+		SetCursorMode(spec.CursorMode);
+		SetCursorShape(spec.CursorShape);
+
+		ApplyIcons(m_Handle, spec);
+
+		m_WasDecorated        = spec.IsDecorated;
+		m_IsTextInputOnDemand = spec.TextInputOnDemand;
+		m_IsTextInputActive   = !spec.TextInputOnDemand;
+		m_RefreshRate         = spec.RefreshRate;
+		m_FullscreenMonitor   = spec.FullscreenMonitor;
+		m_DropChunkSize       = spec.DropChunkSize;
+		m_FullscreenMode      = spec.FullscreenMode;
+		m_IsLateLatchEnabled  = spec.LateLatchInput;
+		m_ThrottlePolicy      = spec.Throttle;
+
+		SetCharCallbackEnabled(m_IsTextInputActive);
+
+		EnableEvents(spec.Events);
+		DisableEvents(~spec.Events);
+
+		if (spec.IsMaximized)
+			Maximize();
+
+		if (spec.IsVisible)
+			Show();
+
+		if (spec.IsVisible && spec.IsFocused)
+			Focus();
+	}
+
+	void Window::Recycle()
+	{
+		if (m_IsFullScreen)
+			SetFullscreen(false);
+
+		if (IsMaximized() || IsMinimized())
+			Restore();
+
+		// Last, restoring an iconified window shows it again on some platforms (X11, Win32)
+		Hide();
+
+		SetShouldClose(false);
+		ClearTextInput();
+		ResetPresentStatistics();
+
+		m_DropArena.clear();
+		m_DropPaths.clear();
+
+		m_IsOverTitleBar = false;
+
+		ClearTitlebarRegions();
+
+		// The next owner's events must not resume the previous owner's tasks
+		m_Device->GetScheduler().ForgetWindow(this);
+	}
+
+	void Window::SetCharCallbackEnabled(bool enabled)
+	{
+		if (!enabled)
+		{
+			glfwSetCharCallback(m_Handle, nullptr);
+
+			return;
+		}
+
+		// Only appends to the arena, consumers read the whole frame's text at once with GetTextInput
+		glfwSetCharCallback(m_Handle, [](GLFWwindow* glfwWindow, unsigned int codepoint) {
+			Window* window = FindInstance(glfwWindow);
+
+			ASSERT(window, "Window handle is null!");
+
+			char encoded[4];
+			const int length = EncodeUTF8(codepoint, encoded);
+
+			window->m_TextInput.append(encoded, length);
+			window->RecordEvent(EventRecordType::Char, (int)codepoint);
+		});
+	}
+
 	void Window::SetShouldClose(bool value) const
 	{
 		glfwSetWindowShouldClose(m_Handle, value);
@@ -403,6 +1123,117 @@ namespace SW::Windowing
 		m_IsOverTitleBar = over;
 	}
 
+	void Window::RemoveBatchListener(Eventing::ListenerID listener)
+	{
+		if (!m_EventBatch)
+			return;
+
+		// The batch storage is kept, the listener may be removed during the flush
+		if (m_EventBatch->Listeners -= listener)
+			m_EventBatch->ListenerCount--;
+	}
+
+	void Window::AppendRecord(const EventRecord& record)
+	{
+		if (m_EventBatch->Records.empty())
+			s_BATCHED_WINDOWS.push_back(this);
+
+		m_EventBatch->Records.push_back(record);
+	}
+
+	void Window::FlushEventBatches()
+	{
+		if (s_BATCHED_WINDOWS.empty())
+			return;
+
+		// The listeners may cause new events, those are delivered by the next flush
+		s_FLUSHED_WINDOWS.swap(s_BATCHED_WINDOWS);
+
+		for (size_t i = 0; i < s_FLUSHED_WINDOWS.size(); i++)
+		{
+			if (s_FLUSHED_WINDOWS[i] == nullptr)
+				continue;
+
+			EventBatch& batch = *s_FLUSHED_WINDOWS[i]->m_EventBatch;
+
+			batch.Delivered.swap(batch.Records);
+
+			// Recorded before the last listener was removed
+			if (batch.ListenerCount > 0)
+			{
+				s_FLUSHING_WINDOW = s_FLUSHED_WINDOWS[i];
+
+				batch.Listeners.Invoke(std::span<const EventRecord>(batch.Delivered));
+
+				s_FLUSHING_WINDOW = nullptr;
+			}
+
+			batch.Delivered.clear();
+
+			// The window was destroyed by a listener, its batch outlived the invocation
+			s_ORPHANED_BATCH.reset();
+		}
+
+		s_FLUSHED_WINDOWS.clear();
+	}
+
+	void Window::SetTitlebarRegions(std::span<const WindowRect> dragAreas, std::span<const WindowRect> captionButtons,
+	                                std::span<const WindowRect> exclusions)
+	{
+		m_TitlebarRegions.clear();
+
+		for (const WindowRect& rect : captionButtons)
+			m_TitlebarRegions.push_back({rect, TitlebarHit::Caption});
+
+		for (const WindowRect& rect : exclusions)
+			m_TitlebarRegions.push_back({rect, TitlebarHit::None});
+
+		for (const WindowRect& rect : dragAreas)
+			m_TitlebarRegions.push_back({rect, TitlebarHit::Drag});
+
+		if (m_TitlebarRegions.empty())
+		{
+			m_TitlebarBounds = {};
+
+			return;
+		}
+
+		int left   = INT_MAX;
+		int top    = INT_MAX;
+		int right  = INT_MIN;
+		int bottom = INT_MIN;
+
+		for (const TitlebarRegion& region : m_TitlebarRegions)
+		{
+			left   = std::min(left, region.Rect.X);
+			top    = std::min(top, region.Rect.Y);
+			right  = std::max(right, region.Rect.X + region.Rect.Width);
+			bottom = std::max(bottom, region.Rect.Y + region.Rect.Height);
+		}
+
+		m_TitlebarBounds = {left, top, right - left, bottom - top};
+	}
+
+	void Window::ClearTitlebarRegions()
+	{
+		m_TitlebarRegions.clear();
+		m_TitlebarBounds = {};
+	}
+
+	TitlebarHit Window::HitTestTitlebar(int x, int y) const
+	{
+		if (!m_TitlebarBounds.Contains(x, y))
+			return TitlebarHit::None;
+
+		for (const TitlebarRegion& region : m_TitlebarRegions)
+		{
+			if (region.Rect.Contains(x, y))
+				return region.Hit;
+		}
+
+		return TitlebarHit::None;
+	}
+
 	float32 Window::GetDPIApproximate() const
 	{
 		float xscale, yscale;
@@ -5,7 +5,12 @@
  */
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #ifdef WINDOWING_EXPOSE_NATIVE_WIN32
 	#include <Windows.h>
@@ -14,22 +19,206 @@
 #include <Eventing/Eventing.hpp>
 
 #include "Windowing/Device.hpp"
+#include "Windowing/IconSet.hpp"
 #include "Windowing/KeyCode.hpp"
+#include "Windowing/LazyEvent.hpp"
 #include "Windowing/MouseCode.hpp"
 
 struct GLFWwindow;
 
 namespace SW::Windowing
 {
-	using uchar = unsigned char;
+	class Window;
+	enum class FullscreenMode
+	{
+		// Switches the monitor's video mode, may blank the screens and recreate the surfaces
+		Exclusive,
+
+		// Undecorated window covering the whole monitor, no video mode change
+		Borderless,
+	};
+
+	enum class VSyncMode
+	{
+		// Swap interval 0, presents immediately (may tear)
+		Off,
+
+		// Swap interval 1, waits for the vertical blank
+		On,
+
+		// Swap interval -1, waits for the vertical blank unless the frame is late, then tears instead of stalling.
+		// Falls back to On if the driver does not support the swap control tear extension.
+		Adaptive,
+	};
+
+	enum class EventRecordType : unsigned char
+	{
+		KeyPressed,
+		KeyReleased,
+		KeyRepeat,
+		MouseButtonPressed,
+		MouseButtonReleased,
+		MouseScroll,
+		CursorMove,
+		Char,
+		Resize,
+		FramebufferResize,
+		Move,
+		Minimize,
+		Restore,
+		GainFocus,
+		LostFocus,
+		Close,
+	};
+
+	// Compact record of a single window event delivered to the batch listeners, see Window::AddBatchListener
+	struct EventRecord
+	{
+		EventRecordType Type = EventRecordType::KeyPressed;
+
+		// Key code, mouse button code or the typed codepoint
+		int Code = 0;
+
+		// Cursor position, scroll offset, new (framebuffer) size or position
+		float X = 0.0f;
+		float Y = 0.0f;
+	};
+
+	// Rectangle in the window's content area coordinates (pixels from the top-left corner)
+	struct WindowRect
+	{
+		int X      = 0;
+		int Y      = 0;
+		int Width  = 0;
+		int Height = 0;
+
+		bool Contains(int x, int y) const { return x >= X && y >= Y && x < X + Width && y < Y + Height; }
+	};
+
+	// Result of the custom titlebar hit test
+	enum class TitlebarHit
+	{
+		// Client area (or an excluded titlebar widget), the application handles the input
+		None,
+
+		// Drags the window
+		Drag,
+
+		// Caption button (minimize, maximize, close) drawn by the application, does not drag
+		Caption,
+	};
+
+	// How visible the window is to the user, tracked by the iconify and focus callbacks
+	enum class ActivityState
+	{
+		Focused,
+
+		// Visible, but another window has the input focus (possibly covering it)
+		Unfocused,
+
+		Hidden,
+		Iconified,
+	};
+
+	// Frame rates (frames per second) Window::Throttle limits the loop to in each of the activity states
+	struct ThrottlePolicy
+	{
+		// Not limited by the throttling (the vsync or frame pacing decides)
+		static constexpr float Unlimited = 0.0f;
+
+		// No frames at all, Window::Throttle blocks until the state changes
+		static constexpr float Paused = -1.0f;
+
+		float FocusedFrameRate   = Unlimited;
+		float UnfocusedFrameRate = 10.0f;
+		float HiddenFrameRate    = 10.0f;
+		float IconifiedFrameRate = Paused;
+	};
+
+	// Event kinds whose platform callbacks a window installs. An event kind that is not enabled costs nothing,
+	// its events are never invoked. Resize, move, iconify, focus and close callbacks are always installed.
+	enum class WindowEvents : unsigned int
+	{
+		None = 0,
+
+		// KeyPressedEvent, KeyReleasedEvent and KeyRepeatEvent
+		Key = 1 << 0,
 
-	struct EmbeddedIcon
+		// MouseButtonPressedEvent and MouseButtonReleasedEvent
+		MouseButton = 1 << 1,
+
+		// MouseScrollWheelEvent
+		Scroll = 1 << 2,
+
+		// CursorMoveEvent
+		CursorMove = 1 << 3,
+
+		// FramebufferResizeEvent
+		FramebufferResize = 1 << 4,
+
+		// DropEvent and DropChunkEvent
+		Drop = 1 << 5,
+
+		All = Key | MouseButton | Scroll | CursorMove | FramebufferResize | Drop,
+	};
+
+	constexpr WindowEvents operator|(WindowEvents left, WindowEvents right)
+	{
+		return (WindowEvents)((unsigned int)left | (unsigned int)right);
+	}
+
+	constexpr WindowEvents operator&(WindowEvents left, WindowEvents right)
+	{
+		return (WindowEvents)((unsigned int)left & (unsigned int)right);
+	}
+
+	constexpr WindowEvents operator~(WindowEvents events)
+	{
+		return (WindowEvents)(~(unsigned int)events & (unsigned int)WindowEvents::All);
+	}
+
+	constexpr bool HasEvents(WindowEvents mask, WindowEvents events)
+	{
+		return (mask & events) != WindowEvents::None;
+	}
+
+	struct PresentStatistics
+	{
+		// Number of SwapBuffers calls
+		unsigned long long PresentCount = 0;
+
+		// Number of presents which came later than expected by the swap interval and the monitor's refresh rate
+		unsigned long long MissedVBlankCount = 0;
+
+		// Time (in seconds) the last SwapBuffers call was blocking
+		double LastBlockingTime = 0.0;
+
+		// Time (in seconds) between the last two SwapBuffers calls
+		double LastPresentInterval = 0.0;
+
+		// Exponential moving averages (in seconds)
+		double AverageBlockingTime    = 0.0;
+		double AveragePresentInterval = 0.0;
+
+		// Refresh period (in seconds) of the monitor the window was presented on, 0 if unknown
+		double RefreshPeriod = 0.0;
+	};
+
+	// Cursor and mouse buttons sampled right before the present, see Window::LatchInput
+	struct LatchedInput
 	{
-		// Embedded binary icon of the application.
-		const uchar* Data = nullptr;
+		// Number of the latches so far, 0 if the input was never latched
+		unsigned long long Sequence = 0;
+
+		// Device time (in seconds) of the latch
+		double Time = 0.0;
 
-		// Number of embedded binary fragments.
-		const int Size = 0;
+		std::pair<float, float> MousePosition;
+
+		// Bit per MouseCode, set if the button is down
+		unsigned int MouseButtons = 0;
+
+		bool IsMouseButtonDown(MouseCode button) const { return (MouseButtons >> button) & 1u; }
 	};
 
 	struct WindowSpecification
@@ -42,8 +231,12 @@ namespace SW::Windowing
 		int Height = 720;
 
 		// Window's icon, shown only if toolbar is enabled
+		// All the IconSet::GeneratedSizes are generated from it, unless Icons are provided
 		EmbeddedIcon Icon = {};
 
+		// Pre-supplied sizes of the window's icon (e.g. 16x16, 32x32, 256x256), used instead of Icon
+		std::span<const EmbeddedIcon> Icons = {};
+
 		int MinimumWidth  = WindowSpecification::DontCare;
 		int MinimumHeight = WindowSpecification::DontCare;
 		int MaximumWidth  = WindowSpecification::DontCare;
@@ -52,6 +245,12 @@ namespace SW::Windowing
 		// Specifies if the window is by default in full screen or windowed mode
 		bool IsFullScreen = false;
 
+		// Index of the monitor (in Device::GetMonitors) used for full screen mode, 0 is the primary monitor
+		int FullscreenMonitor = 0;
+
+		// Strategy used when entering the full screen mode
+		FullscreenMode FullscreenMode = FullscreenMode::Exclusive;
+
 		// Specifies whether the windowed mode window will have window decorations such as a border, widgets etc.
 		// This hint is ignored for full screen windows
 		bool IsDecorated = true;
@@ -89,12 +288,35 @@ namespace SW::Windowing
 		CursorMode CursorMode = CursorMode::NORMAL;
 
 		CursorShape CursorShape = CursorShape::ARROW;
+
+		// Specifies whether typed text is collected only between BeginTextInput and EndTextInput calls
+		// (e.g. while a text field has focus). When false, text is collected for the whole window lifetime.
+		bool TextInputOnDemand = false;
+
+		// Initial capacity (in bytes) of the per-frame UTF-8 text input buffer, grows on demand
+		int TextInputCapacity = 256;
+
+		// Number of dropped paths delivered per DropChunkEvent invocation, 0 (default) disables the chunked delivery
+		int DropChunkSize = 0;
+
+		// Window whose context objects (textures, buffers, shaders) the new window's context shares
+		Window* SharedContext = nullptr;
+
+		// Event kinds the window listens to, e.g. WindowEvents::None for headless tool windows.
+		// Listeners (including the InputManager) of the disabled event kinds are never invoked.
+		WindowEvents Events = WindowEvents::All;
+
+		// Specifies whether the input is latched right before every SwapBuffers call, see Window::LatchInput
+		bool LateLatchInput = false;
+
+		// Background frame rates applied by Window::Throttle
+		ThrottlePolicy Throttle = {};
 	};
 
 	class Window
 	{
 	public:
-		Window(const Device* device, const WindowSpecification& spec);
+		Window(Device* device, const WindowSpecification& spec);
 		~Window();
 
 		static Window* FindInstance(GLFWwindow* glfwWindow);
@@ -133,20 +355,62 @@ namespace SW::Windowing
 		bool IsFocused() const;
 		void Focus() const;
 
+		ActivityState GetActivityState() const;
+
+		const ThrottlePolicy& GetThrottlePolicy() const { return m_ThrottlePolicy; }
+		void SetThrottlePolicy(const ThrottlePolicy& policy) { m_ThrottlePolicy = policy; }
+
+		// Frame rate of the current activity state, ThrottlePolicy::Unlimited or ThrottlePolicy::Paused included
+		float GetThrottledFrameRate() const;
+
+		// Call at the start of the frame (before PollEvents). Blocks in Device::WaitEvents until the next frame is
+		// due by the policy, returns immediately if the current state is unlimited. Any state change (e.g. restore
+		// or focus) wakes it up instantly. Returns false if the window should close meanwhile.
+		bool Throttle();
+
 		// Set the should close flag of the window
 		void SetShouldClose(bool value) const;
 		// Return true if the window should close
 		bool ShouldClose() const;
 
 		// Set the state of titlebar drag, used for the window handle to allow for custom way of drag
-		// (Whether to enable or disable custom drag)
+		// (Whether to enable or disable custom drag). Used only if no titlebar regions are set.
 		void RegisterOverTitlebar(bool over);
 		bool IsOverTitleBar() const { return m_IsOverTitleBar; }
 
+		// Custom titlebar layout, the hit test callback checks the exact cursor position against it, so nothing
+		// has to be computed per frame. Caption buttons and exclusions (e.g. menus, tabs, search boxes drawn in
+		// the titlebar) take precedence over the drag areas. Set it again whenever the layout changes (e.g. resize).
+		void SetTitlebarRegions(std::span<const WindowRect> dragAreas, std::span<const WindowRect> captionButtons = {},
+		                        std::span<const WindowRect> exclusions = {});
+
+		// Falls back to RegisterOverTitlebar
+		void ClearTitlebarRegions();
+
+		TitlebarHit HitTestTitlebar(int x, int y) const;
+
 		bool IsFullscreen() const;
 		void SetFullscreen(bool value);
 		void ToggleFullscreen();
 
+		// Toggles the full screen using the given strategy instead of the window's one
+		void ToggleFullscreen(FullscreenMode mode);
+
+		// Switches to exclusive full screen on the given monitor using the given video mode
+		void SetFullscreen(const MonitorInfo& monitor, const VideoMode& mode);
+
+		// Switches to borderless full screen covering the given monitor's work area (the task bars stay visible),
+		// keeps its video mode
+		void SetBorderlessFullscreen(const MonitorInfo& monitor);
+
+		// Strategy used by SetFullscreen(true) and ToggleFullscreen
+		FullscreenMode GetFullscreenMode() const { return m_FullscreenMode; }
+		void SetFullscreenMode(FullscreenMode mode) { m_FullscreenMode = mode; }
+
+		// Index of the monitor (in Device::GetMonitors) used by SetFullscreen(true) and ToggleFullscreen
+		int GetFullscreenMonitor() const { return m_FullscreenMonitor; }
+		void SetFullscreenMonitor(int monitorIndex) { m_FullscreenMonitor = monitorIndex; }
+
 		bool IsResizable() const;
 		bool IsDecorated() const;
 		bool HasTitlebar() const;
@@ -155,18 +419,76 @@ namespace SW::Windowing
 		void MakeContextCurrent() const;
 
 		// Handle the buffer swapping with the current window
-		void SwapBuffers() const;
+		void SwapBuffers();
+
+		// Drains the OS event queue without blocking, then samples the cursor position and mouse buttons state into
+		// the latch slot. Called by SwapBuffers when the late latch is enabled. Main thread only, so the frame must
+		// follow the PollEvents -> PublishSnapshot -> ClearReleasedKeys -> ... -> SwapBuffers order, and the listeners
+		// of the drained events must not destroy the window. The drained events reach the batch listeners and the
+		// waiting tasks with the next PollEvents call.
+		void LatchInput();
+
+		// The last latched input, lock-free and safe to read from any thread (e.g. by the renderer drawing
+		// the cursor, crosshair or drag handles right before the present)
+		LatchedInput GetLatchedInput() const;
+
+		bool IsLateLatchEnabled() const { return m_IsLateLatchEnabled; }
+		void SetLateLatchEnabled(bool enabled) { m_IsLateLatchEnabled = enabled; }
+
+		// Swap interval of the window's context, applied no matter which context is current.
+		// Negative values enable the adaptive vsync (if supported), see VSyncMode::Adaptive.
+		// Does nothing for the windows without a context (ClientApi::Vulkan).
+		int GetSwapInterval() const { return m_SwapInterval; }
+		void SetSwapInterval(int interval);
+
+		VSyncMode GetVSync() const;
+		void SetVSync(VSyncMode mode);
+
+		bool IsVSyncEnabled() const { return m_SwapInterval != 0; }
+
+		// Timings of the SwapBuffers calls, use them to detect missed vertical blanks and choose the vsync mode
+		const PresentStatistics& GetPresentStatistics() const { return m_PresentStatistics; }
+		void ResetPresentStatistics() { m_PresentStatistics = {}; }
 
 		CursorMode GetCursorMode() const { return m_CursorMode; }
 		void SetCursorMode(CursorMode cursorMode);
 
 		CursorShape GetCursorShape() const { return m_CursorShape; }
+
+		// Does nothing if the shape is already set, so it can be called every frame (e.g. by hovered widgets)
 		void SetCursorShape(CursorShape cursorShape);
 
+		// Custom cursor created by the device, InvalidCursor if a standard shape is used
+		CursorID GetCursor() const { return m_Cursor; }
+
+		// Sets the custom (possibly animated) cursor created by the device, does nothing if it is already set
+		void SetCursor(CursorID cursor);
+
 		void SetCursorPosition(int x, int y);
 
-		std::string GetTitle() const { return m_Title; }
-		void SetTitle(const std::string& title);
+		// Returns the UTF-8 encoded text typed since the last ClearTextInput call.
+		// The view is valid until the next ClearTextInput or PollEvents call.
+		std::string_view GetTextInput() const { return m_TextInput; }
+
+		// Appends already UTF-8 encoded text (e.g. clipboard contents) to the text input in a single copy
+		void AppendTextInput(std::string_view text);
+
+		// Resets the text input buffer, keeping its memory.
+		// Be aware that this function should be called at the end of the frame.
+		void ClearTextInput();
+
+		// Starts collecting typed text, used only if the window was created with TextInputOnDemand
+		void BeginTextInput();
+		// Stops collecting typed text, used only if the window was created with TextInputOnDemand
+		void EndTextInput();
+
+		bool IsTextInputActive() const { return m_IsTextInputActive; }
+
+		const std::string& GetTitle() const { return m_Title; }
+
+		// Does nothing if the title is unchanged, so it can be called every frame. A changed title reuses the storage
+		// of the previous one, but GLFW (3.4) copies every new title to the heap.
+		void SetTitle(std::string_view title);
 
 		int GetRefreshRate() const { return m_RefreshRate; }
 		void SetRefreshRate(int refreshRate) { m_RefreshRate = refreshRate; }
@@ -180,31 +502,91 @@ namespace SW::Windowing
 
 		GLFWwindow* GetWindowHandle() const { return m_Handle; }
 
+		// Awaitables for the device's tasks (see Task), require the Key event kind for KeyPressed
+		WindowEventAwaiter KeyPressed(KeyCode key) const { return {this, WaitEvent::KeyPressed, key}; }
+		WindowEventAwaiter Resized() const { return {this, WaitEvent::Resized, 0}; }
+
+		WindowEvents GetEnabledEvents() const { return m_EnabledEvents; }
+
+		// Installs or removes the platform callbacks of the event kinds at runtime (e.g. when a secondary viewport
+		// gains its first listener). Must not be called while a StaticEventDispatcher is attached.
+		void EnableEvents(WindowEvents events);
+		void DisableEvents(WindowEvents events);
+
 #ifdef WINDOWING_EXPOSE_NATIVE_WIN32
 		HWND GetWin32WindowHandle() const;
 #endif
 
 	public:
 		// Inputs relative events
-		Eventing::Event<Windowing::KeyCode> KeyPressedEvent;
-		Eventing::Event<Windowing::KeyCode> KeyReleasedEvent;
-		Eventing::Event<Windowing::KeyCode> KeyRepeatEvent;
+		LazyEvent<Windowing::KeyCode> KeyPressedEvent;
+		LazyEvent<Windowing::KeyCode> KeyReleasedEvent;
+		LazyEvent<Windowing::KeyCode> KeyRepeatEvent;
 
-		Eventing::Event<Windowing::MouseCode> MouseButtonPressedEvent;
-		Eventing::Event<Windowing::MouseCode> MouseButtonReleasedEvent;
-		Eventing::Event<float, float> MouseScrollWheelEvent;
+		LazyEvent<Windowing::MouseCode> MouseButtonPressedEvent;
+		LazyEvent<Windowing::MouseCode> MouseButtonReleasedEvent;
+		LazyEvent<float, float> MouseScrollWheelEvent;
 
 		// Window events
-		Eventing::Event<int, int> ResizeEvent;
-		Eventing::Event<int, int> FramebufferResizeEvent;
-		Eventing::Event<int, int> MoveEvent;
-		Eventing::Event<float, float> CursorMoveEvent;
+		LazyEvent<int, int> ResizeEvent;
+		LazyEvent<int, int> FramebufferResizeEvent;
+		LazyEvent<int, int> MoveEvent;
+		LazyEvent<float, float> CursorMoveEvent;
+
+		LazyEvent<> MinimizeEvent;
+		LazyEvent<> MaximizeEvent;
+		LazyEvent<> GainFocusEvent;
+		LazyEvent<> LostFocusEvent;
+		LazyEvent<> CloseEvent;
+
+		// Paths of the files dropped on the window, all at once.
+		// The views are stored in a single per-window arena and stay valid until the next drop.
+		LazyEvent<std::span<const std::string_view>> DropEvent;
+
+		// Streaming variant of DropEvent, invoked with consecutive chunks of the dropped paths as soon as they
+		// are copied (before the whole list is built)
+		LazyEvent<std::span<const std::string_view>> DropChunkEvent;
+
+		// Batch listeners get all the window's events received during a Device::PollEvents/WaitEvents call at once
+		// (in order), a single invocation instead of one per event. The events are recorded only while there is
+		// a batch listener. The span is valid only during the invocation. Drops and the events dispatched by
+		// a StaticEventDispatcher are not recorded.
+		template <typename Callback>
+		Eventing::ListenerID AddBatchListener(Callback&& callback)
+		{
+			if (!m_EventBatch)
+				m_EventBatch = std::make_unique<EventBatch>();
+
+			m_EventBatch->ListenerCount++;
+
+			return m_EventBatch->Listeners += std::forward<Callback>(callback);
+		}
+
+		void RemoveBatchListener(Eventing::ListenerID listener);
 
-		Eventing::Event<> MinimizeEvent;
-		Eventing::Event<> MaximizeEvent;
-		Eventing::Event<> GainFocusEvent;
-		Eventing::Event<> LostFocusEvent;
-		Eventing::Event<> CloseEvent;
+	private:
+		struct EventBatch
+		{
+			Eventing::Event<std::span<const EventRecord>> Listeners;
+
+			int ListenerCount = 0;
+
+			// Filled by the callbacks, swapped with the delivered ones on flush (both keep their storage)
+			std::vector<EventRecord> Records;
+			std::vector<EventRecord> Delivered;
+		};
+
+		// Single branch on the callback path when there is no batch listener
+		void RecordEvent(EventRecordType type, int code = 0, float x = 0.0f, float y = 0.0f)
+		{
+			if (m_EventBatch && m_EventBatch->ListenerCount > 0)
+				AppendRecord({type, code, x, y});
+		}
+
+		void AppendRecord(const EventRecord& record);
+
+		// Called by the device at the end of every poll, delivers the recorded batches
+		static void FlushEventBatches();
 
 	private:
 		void OnResize(int width, int height);
@@ -212,26 +594,123 @@ namespace SW::Windowing
 
 		void UpdateSizeLimit() const;
 
+		const MonitorInfo& GetSelectedMonitor() const;
+
+		void RecordPresent(double startTime, double endTime);
+
+		void SetCharCallbackEnabled(bool enabled);
+
+		void SetEventCallbacks(WindowEvents events, bool enabled);
+
+		void OnDrop(int count, const char* paths[]);
+
+		// Used by the device's window pool, applies the run-time changeable part of the specification
+		void Reuse(const WindowSpecification& spec);
+
+		// Used by the device's window pool, hides the window and resets its per-use state
+		void Recycle();
+
 	private:
-		const Device* m_Device = nullptr;
-		GLFWwindow* m_Handle   = nullptr;
+		friend class Device;
 
-		std::string m_Title;
+		struct TitlebarRegion
+		{
+			WindowRect Rect;
+
+			TitlebarHit Hit = TitlebarHit::None;
+		};
+
+		// Hot state of the size, move and char callbacks, kept in one cache line
+
+		alignas(64) GLFWwindow* m_Handle = nullptr;
 
 		std::pair<int, int> m_Size;
-		std::pair<int, int> m_MinimumSize;
-		std::pair<int, int> m_MaximumSize;
 		std::pair<int, int> m_Position;
 
+		// Per-frame UTF-8 arena filled by the char callback
+		std::string m_TextInput;
+
 		bool m_IsFullScreen;
-		bool m_IsOverTitleBar;
+		bool m_IsOverTitleBar = false;
+
+		// Warm state, read by the titlebar hit test and the callbacks signaling the device, on the next cache line
+
+		alignas(64) Device* m_Device = nullptr;
+
+		// Bounding box of all the regions, most of the hit tests (in the client area) end on it
+		WindowRect m_TitlebarBounds;
+
+		// Ordered by precedence: caption buttons, exclusions, drag areas
+		std::vector<TitlebarRegion> m_TitlebarRegions;
+
+		// Cold state, touched only by the explicit calls
+
+		std::string m_Title;
+
+		// Arena with all the paths of the last drop and the views of them
+		std::string m_DropArena;
+		std::vector<std::string_view> m_DropPaths;
+
+		std::pair<int, int> m_MinimumSize;
+		std::pair<int, int> m_MaximumSize;
+
+		// Size of the window before entering full screen mode
+		std::pair<int, int> m_WindowedSize;
+
+		bool m_IsBorderlessFullScreen = false;
+		bool m_WasDecorated;
+		bool m_IsTextInputOnDemand;
+		bool m_IsTextInputActive;
+
+		// Updated by the iconify and focus callbacks
+		bool m_IsIconified = false;
+		bool m_IsFocused   = false;
 
 		int m_RefreshRate;
+		int m_FullscreenMonitor;
+		int m_SwapInterval = 0;
+		int m_DropChunkSize;
+
+		// Time of the end of the last SwapBuffers call
+		double m_LastPresentTime = 0.0;
+
+		PresentStatistics m_PresentStatistics;
+
+		FullscreenMode m_FullscreenMode;
+
+		WindowEvents m_EnabledEvents;
 
 		CursorMode m_CursorMode;
 		CursorShape m_CursorShape;
+		CursorID m_Cursor = InvalidCursor;
+
+		bool m_IsLateLatchEnabled;
+
+		ThrottlePolicy m_ThrottlePolicy;
+
+		// Time of the last frame let through by Throttle
+		double m_LastThrottledFrameTime = 0.0;
+
+		// Allocated with the first batch listener
+		std::unique_ptr<EventBatch> m_EventBatch;
+
+		// Sequence lock of the latched input, odd while the main thread writes the fields
+		std::atomic<unsigned long long> m_LatchSequence = 0;
+
+		std::atomic<double> m_LatchTime               = 0.0;
+		std::atomic<float> m_LatchMouseX              = 0.0f;
+		std::atomic<float> m_LatchMouseY              = 0.0f;
+		std::atomic<unsigned int> m_LatchMouseButtons = 0;
 
 	private:
 		static std::unordered_map<GLFWwindow*, Window*> s_WINDOWS;
+
+		// Windows with recorded events since the last flush, and the ones being flushed (null once destroyed)
+		static std::vector<Window*> s_BATCHED_WINDOWS;
+		static std::vector<Window*> s_FLUSHED_WINDOWS;
+
+		// Window whose batch listeners are being invoked, and its batch if a listener destroyed the window
+		static Window* s_FLUSHING_WINDOW;
+		static std::unique_ptr<EventBatch> s_ORPHANED_BATCH;
 	};
 } // namespace SW::Windowing